@@ -0,0 +1,455 @@
+// bh_bench.cpp
+// Microbenchmarks of the bh_physics kernels (no window, no GL), run like Google
+// Benchmark: each case runs in batches that grow until one takes --min-time, then
+// --repetitions batches are timed and reduced to mean / median / stddev.
+// Usage: bh_bench [--filter SUBSTR] [--min-time S=0.2] [--repetitions N=3] [--threads T=0]
+//                 [--json FILE] [--compare BASELINE.json]
+// --json writes Google Benchmark's JSON layout (one entry per repetition plus the
+// aggregates), so its tools/compare.py reads it too. --compare reads such a file and
+// prints the change of each case's median against it.
+
+#include "geodesic.hpp"
+#include "mesh_gen.hpp"
+#include "metric.hpp"
+#include "nbody.hpp"
+#include "parallel_for.hpp"
+#include "photon_ring.hpp"
+#include "spacetime_grid.hpp"
+#include "text_mesh.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const uint64_t kSeed = 0x5eedb1ac4401eull;   // MESH_SEED in black_hole.cpp
+
+// Written by every kernel so the optimizer keeps the work
+static volatile uint64_t benchSink;
+
+struct BenchCase {
+    std::string name;
+    // Does the setup (untimed) and returns the kernel; items = work units per call
+    // (points, particle steps, ...) for the items/s counter, 0 for none
+    std::function<std::function<void()>(double &items)> make;
+};
+
+struct BenchRun {
+    int64_t iterations = 0;
+    double realNs = 0.0, cpuNs = 0.0;   // per iteration
+};
+
+struct BenchResult {
+    std::string name;
+    double items = 0.0;
+    std::vector<BenchRun> runs;
+    BenchRun mean, median, stddev;
+};
+
+static BenchRun runBatch(const std::function<void()> &kernel, int64_t iters) {
+    clock_t c0 = clock();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < iters; ++i) kernel();
+    double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double cpu = double(clock() - c0) / CLOCKS_PER_SEC;
+    BenchRun r;
+    r.iterations = iters;
+    r.realNs = real * 1e9 / iters;
+    r.cpuNs = cpu * 1e9 / iters;
+    return r;
+}
+
+static BenchResult runCase(const BenchCase &c, double minTime, int repetitions) {
+    BenchResult res;
+    res.name = c.name;
+    std::function<void()> kernel = c.make(res.items);
+
+    // grow the batch until it takes minTime (the same rule as Google Benchmark)
+    int64_t iters = 1;
+    for (;;) {
+        BenchRun r = runBatch(kernel, iters);
+        double seconds = r.realNs * iters * 1e-9;
+        if (seconds >= minTime || iters >= 1000000000) break;
+        double multiplier = seconds / minTime > 0.1 ? minTime * 1.4 / std::max(seconds, 1e-9) : 10.0;
+        iters = std::max<int64_t>(iters + 1, (int64_t)std::ceil(iters * multiplier));
+    }
+    for (int rep = 0; rep < repetitions; ++rep) res.runs.push_back(runBatch(kernel, iters));
+
+    auto reduce = [&](double BenchRun::*field, double &mean, double &median, double &stddev) {
+        std::vector<double> v;
+        for (const BenchRun &r : res.runs) v.push_back(r.*field);
+        std::sort(v.begin(), v.end());
+        double sum = 0.0, sq = 0.0;
+        for (double x : v) sum += x;
+        mean = sum / v.size();
+        for (double x : v) sq += (x - mean) * (x - mean);
+        stddev = v.size() > 1 ? std::sqrt(sq / (v.size() - 1)) : 0.0;
+        median = v.size() % 2 ? v[v.size() / 2] : 0.5 * (v[v.size() / 2 - 1] + v[v.size() / 2]);
+    };
+    reduce(&BenchRun::realNs, res.mean.realNs, res.median.realNs, res.stddev.realNs);
+    reduce(&BenchRun::cpuNs, res.mean.cpuNs, res.median.cpuNs, res.stddev.cpuNs);
+    res.mean.iterations = res.median.iterations = res.stddev.iterations = iters;
+    return res;
+}
+
+// ---------------------------------------------------------------- cases
+
+// Point clouds are filled into a buffer allocated once, standing in for the mapped VBO
+static std::vector<BenchCase> makeCases(unsigned threads) {
+    std::vector<BenchCase> cases;
+
+    for (int res : { 256, 512, 1000, 2048 }) {
+        cases.push_back({ "generateBlackHolePixels/res:" + std::to_string(res), [res, threads](double &items) {
+            auto layout = std::make_shared<BlackHolePixelLayout>();
+            blackHolePixelLayout(*layout, res, 0.65f);
+            auto buf = std::make_shared<std::vector<Pixel>>(layout->count);
+            items = double(layout->count);
+            return std::function<void()>([layout, buf, res, threads] {
+                blackHolePixelLayout(*layout, res, 0.65f);
+                fillBlackHolePixels(buf->data(), *layout, threads);
+                benchSink += layout->count;
+            });
+        } });
+    }
+
+    for (int scale : { 1, 8 }) {
+        int radial = 36 * scale, angular = 360 * scale;
+        cases.push_back({ "generateDiskPixelsWorld/" + std::to_string(radial) + "x" + std::to_string(angular),
+                          [radial, angular, threads](double &items) {
+            auto buf = std::make_shared<std::vector<Pixel>>(diskPixelCount(radial, angular));
+            items = double(buf->size());
+            return std::function<void()>([buf, radial, angular, threads] {
+                fillDiskPixels(buf->data(), 0.5f, 0.95f, 0.04f, radial, angular, -0.28f, kSeed, threads);
+                benchSink += buf->size();
+            });
+        } });
+    }
+
+    for (int samples : { 720, 720 * 16 }) {
+        cases.push_back({ "generatePhotonRingBillboard/samples:" + std::to_string(samples), [samples, threads](double &items) {
+            auto buf = std::make_shared<std::vector<Pixel>>(photonRingPixelCount(samples));
+            items = double(buf->size());
+            return std::function<void()>([buf, samples, threads] {
+                fillPhotonRingPixels(buf->data(), 0.52f, 0.6175f, samples, kSeed, threads);
+                benchSink += buf->size();
+            });
+        } });
+    }
+
+    // same footprint as the renderer's 28 x 0.12 grid, finer lattices
+    for (int gridSize : { 28, 112 }) {
+        cases.push_back({ "generateGrid/size:" + std::to_string(gridSize), [gridSize](double &items) {
+            auto g = std::make_shared<GridGeometry>();
+            float spacing = 0.12f * 28.0f / gridSize;
+            generateGridGeometry(*g, gridSize, spacing, 3.2f);
+            items = double(g->verts.size());
+            return std::function<void()>([g, gridSize, spacing] {
+                generateGridGeometry(*g, gridSize, spacing, 3.2f);
+                benchSink += g->indices.size();
+            });
+        } });
+    }
+
+    // whole tree and mesh from scratch at a near and a far camera
+    for (float radius : { 2.0f, 12.0f }) {
+        char name[64];
+        snprintf(name, sizeof(name), "updateAdaptiveGrid/fresh/radius:%g", radius);
+        cases.push_back({ name, [radius](double &items) {
+            AdaptiveGrid probe;
+            updateAdaptiveGrid(probe, radius);
+            items = double(probe.leafCount);
+            return std::function<void()>([radius] {
+                AdaptiveGrid ag;
+                updateAdaptiveGrid(ag, radius);
+                benchSink += ag.geometry.indices.size();
+            });
+        } });
+    }
+
+    // the six HUD lines of a typical frame, rebuilt into a fresh vector like the renderer
+    cases.push_back({ "buildTextMesh/hud", [](double &items) {
+        static const char *lines[] = {
+            "TimeDilation: 0.912345  SpatialDist: 0.456789",
+            "Cam: 6.500  FPS: 144.0  Frame: 6.94 ms",
+            "Stars: 2  NBody: 20000  Geo: 2048",
+            "GridVerts: 3649 / 3249  Leaves: 1024",
+            "Spin: 0.90  Incl: 60.0  Ring: 5.196",
+            "ResScale: 0.875  GPU: 5.12 / 6.94",
+        };
+        std::vector<TextPoint> probe;
+        for (int i = 0; i < 6; ++i) buildTextMesh(lines[i], 0.02f, 0.95f - 0.09f * i, 0.9f, 1.0f, 0.8f, 0.6f, probe);
+        items = double(probe.size());
+        return std::function<void()>([] {
+            std::vector<TextPoint> pts;
+            for (int i = 0; i < 6; ++i) buildTextMesh(lines[i], 0.02f, 0.95f - 0.09f * i, 0.9f, 1.0f, 0.8f, 0.6f, pts);
+            benchSink += pts.size();
+        });
+    } });
+
+    // bound, mildly eccentric orbits (as geodesic_bench): no particle is lost over a long run
+    for (int particles : { 2048, 65536 }) {
+        cases.push_back({ "geodesicStep/timelike:" + std::to_string(particles), [particles](double &items) {
+            auto b = std::make_shared<GeodesicBatch>();
+            for (int i = 0; i < particles; ++i) {
+                float u = (i + 0.5f) / float(particles);
+                float phase = 6.2831853f * fmodf(i * 0.618034f, 1.0f);
+                geodesicAddOrbit(*b, 6.5f + 23.5f * u, 0.6f * sinf(12.9898f * i), phase, 0.97f + 0.03f * cosf(78.233f * i));
+            }
+            items = double(particles);
+            return std::function<void()>([b] {
+                geodesicStep(*b, 0.02f, 1);
+                benchSink += b->count;
+            });
+        } });
+    }
+
+    // a fan of photons passing the hole at impact parameters around the critical one
+    cases.push_back({ "geodesicStep/null:4096", [](double &items) {
+        auto b = std::make_shared<GeodesicBatch>();
+        b->kind = GeodesicKind::Null;
+        for (int i = 0; i < 4096; ++i) {
+            float p[3] = { -60.0f, 2.0f + 10.0f * (i + 0.5f) / 4096.0f, 0.0f };
+            float d[3] = { 1.0f, 0.0f, 0.0f };
+            geodesicAddRay(*b, p, d);
+        }
+        items = 4096.0;
+        return std::function<void()>([b] {
+            geodesicStep(*b, 0.05f, 1);
+            benchSink += b->count;
+        });
+    } });
+
+    cases.push_back({ "nbodyStep/bodies:20000", [threads](double &items) {
+        auto s = std::make_shared<NBodySystem>();
+        s->params.threads = threads;
+        s->params.softening = 0.005f;
+        nbodyInitOrbitingDisk(*s, 20000, 1.0f, 1e-6f, 1.2f, 3.0f, 0.05f, 1234u);
+        items = 20000.0;
+        return std::function<void()>([s] {
+            nbodyStep(*s, 0.002f);
+            benchSink += s->nodes.size();
+        });
+    } });
+
+    // metric fields over 1M scattered points: the scalar functions in a loop, then the
+    // batched API in float and double
+    const size_t fieldPoints = 1 << 20;
+    auto fieldCoords = [fieldPoints](std::vector<double> &x, std::vector<double> &y, std::vector<double> &z) {
+        x.resize(fieldPoints); y.resize(fieldPoints); z.resize(fieldPoints);
+        for (size_t i = 0; i < fieldPoints; ++i) {
+            x[i] = 4.0 * sin(0.37 * i); y[i] = 1.5 * cos(0.11 * i); z[i] = 4.0 * sin(0.013 * i + 1.0);
+        }
+    };
+    cases.push_back({ "timeDilationFactor/scalar:1M", [fieldCoords, fieldPoints](double &items) {
+        auto d = std::make_shared<std::vector<float>>(fieldPoints);
+        std::vector<double> x, y, z;
+        fieldCoords(x, y, z);
+        for (size_t i = 0; i < fieldPoints; ++i) (*d)[i] = (float)std::sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]);
+        auto out = std::make_shared<std::vector<float>>(fieldPoints);
+        items = double(fieldPoints);
+        return std::function<void()>([d, out] {
+            for (size_t i = 0; i < d->size(); ++i) (*out)[i] = computeTimeDilationFactor(0.585f, (*d)[i]);
+            benchSink += out->size();
+        });
+    } });
+    for (int precision : { 32, 64 }) {
+        for (MetricField field : { MetricField::TimeDilation, MetricField::SpatialDistortion }) {
+            std::string name = std::string("evaluateMetricField/") +
+                               (field == MetricField::TimeDilation ? "dilation" : "deflection") +
+                               (precision == 32 ? "/float" : "/double") + ":1M";
+            cases.push_back({ name, [fieldCoords, fieldPoints, precision, field, threads](double &items) {
+                auto xd = std::make_shared<std::vector<double>>(), yd = std::make_shared<std::vector<double>>(),
+                     zd = std::make_shared<std::vector<double>>(), od = std::make_shared<std::vector<double>>(fieldPoints);
+                fieldCoords(*xd, *yd, *zd);
+                items = double(fieldPoints);
+                if (precision == 64) {
+                    return std::function<void()>([xd, yd, zd, od, field, threads] {
+                        const double c[3] = { 0.0, 0.0, 0.0 };
+                        evaluateMetricField(field, 0.585, c, xd->data(), yd->data(), zd->data(), od->data(), od->size(), threads);
+                        benchSink += od->size();
+                    });
+                }
+                auto x = std::make_shared<std::vector<float>>(xd->begin(), xd->end());
+                auto y = std::make_shared<std::vector<float>>(yd->begin(), yd->end());
+                auto z = std::make_shared<std::vector<float>>(zd->begin(), zd->end());
+                auto o = std::make_shared<std::vector<float>>(fieldPoints);
+                return std::function<void()>([x, y, z, o, field, threads] {
+                    const float c[3] = { 0.0f, 0.0f, 0.0f };
+                    evaluateMetricField(field, 0.585f, c, x->data(), y->data(), z->data(), o->data(), o->size(), threads);
+                    benchSink += o->size();
+                });
+            } });
+        }
+    }
+    // 1024 x 1024 heatmap in the disk plane, coordinates generated on the fly
+    cases.push_back({ "evaluateMetricFieldGrid/dilation/float:1024x1024", [threads](double &items) {
+        auto out = std::make_shared<std::vector<float>>(1024 * 1024);
+        items = double(out->size());
+        return std::function<void()>([out, threads] {
+            const float c[3] = { 0.0f, -0.28f, 0.0f }, origin[3] = { -3.36f, -0.28f, -3.36f };
+            const float step[3] = { 6.72f / 1023, 0.0f, 6.72f / 1023 };
+            evaluateMetricFieldGrid(MetricField::TimeDilation, 0.585f, c, origin, step, 1024, 1, 1024, out->data(), threads);
+            benchSink += out->size();
+        });
+    } });
+
+    cases.push_back({ "computePhotonRingCurve/spin:0.9/points:256", [](double &items) {
+        auto c = std::make_shared<PhotonRingCurve>();
+        items = 256.0;
+        return std::function<void()>([c] {
+            computePhotonRingCurve(*c, 0.9f, 1.0472f, 256);
+            benchSink += c->alpha.size();
+        });
+    } });
+
+    return cases;
+}
+
+// ---------------------------------------------------------------- output
+
+static void writeRunJson(FILE *f, const std::string &name, const std::string &runName, const char *runType,
+                         const char *aggregate, int repetitions, int index, const BenchRun &r, double items, bool last) {
+    fprintf(f, "    {\n");
+    fprintf(f, "      \"name\": \"%s\",\n", name.c_str());
+    fprintf(f, "      \"run_name\": \"%s\",\n", runName.c_str());
+    fprintf(f, "      \"run_type\": \"%s\",\n", runType);
+    if (aggregate) fprintf(f, "      \"aggregate_name\": \"%s\",\n", aggregate);
+    fprintf(f, "      \"repetitions\": %d,\n", repetitions);
+    if (!aggregate) fprintf(f, "      \"repetition_index\": %d,\n", index);
+    fprintf(f, "      \"threads\": 1,\n");
+    fprintf(f, "      \"iterations\": %lld,\n", (long long)r.iterations);
+    fprintf(f, "      \"real_time\": %.6e,\n", r.realNs);
+    fprintf(f, "      \"cpu_time\": %.6e,\n", r.cpuNs);
+    fprintf(f, "      \"time_unit\": \"ns\"");
+    if (items > 0.0 && r.realNs > 0.0 && (!aggregate || strcmp(aggregate, "stddev") != 0))
+        fprintf(f, ",\n      \"items_per_second\": %.6e", items * 1e9 / r.realNs);
+    fprintf(f, "\n    }%s\n", last ? "" : ",");
+}
+
+static bool writeJson(const char *path, const std::vector<BenchResult> &results, const char *exe,
+                      unsigned threads, int repetitions) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return false;
+    }
+    char date[64];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    fprintf(f, "{\n  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n", date);
+    fprintf(f, "    \"executable\": \"%s\",\n", exe);
+    fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    fprintf(f, "    \"kernel_threads\": %u,\n", threads);
+#ifdef NDEBUG
+    fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(f, "  },\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult &r = results[i];
+        for (size_t k = 0; k < r.runs.size(); ++k)
+            writeRunJson(f, r.name, r.name, "iteration", nullptr, repetitions, (int)k, r.runs[k], r.items, false);
+        bool lastCase = i + 1 == results.size();
+        writeRunJson(f, r.name + "_mean", r.name, "aggregate", "mean", repetitions, 0, r.mean, r.items, false);
+        writeRunJson(f, r.name + "_median", r.name, "aggregate", "median", repetitions, 0, r.median, r.items, false);
+        writeRunJson(f, r.name + "_stddev", r.name, "aggregate", "stddev", repetitions, 0, r.stddev, r.items, lastCase);
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+// Medians of a baseline file: scans the "name" / "real_time" fields line by line, which
+// covers this program's output and Google Benchmark's (same layout, one field per line)
+static bool readBaselineMedians(const char *path, std::map<std::string, double> &medians) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "cannot read %s\n", path);
+        return false;
+    }
+    char line[1024];
+    std::string name;
+    while (fgets(line, sizeof(line), f)) {
+        const char *p = strstr(line, "\"name\": \"");
+        if (p) {
+            p += 9;
+            const char *e = strchr(p, '"');
+            name.assign(p, e ? size_t(e - p) : strlen(p));
+            continue;
+        }
+        p = strstr(line, "\"real_time\": ");
+        const std::string suffix = "_median";
+        if (p && name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            medians[name.substr(0, name.size() - suffix.size())] = atof(p + 13);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char *filter = nullptr, *jsonPath = nullptr, *comparePath = nullptr;
+    double minTime = 0.2;
+    int repetitions = 3;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--filter") && hasValue) filter = argv[++i];
+        else if (!strcmp(argv[i], "--min-time") && hasValue) minTime = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--repetitions") && hasValue) repetitions = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--threads") && hasValue) threads = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--json") && hasValue) jsonPath = argv[++i];
+        else if (!strcmp(argv[i], "--compare") && hasValue) comparePath = argv[++i];
+        else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (minTime <= 0.0) minTime = 0.2;
+    if (repetitions < 1) repetitions = 1;
+
+    std::map<std::string, double> baseline;
+    if (comparePath && !readBaselineMedians(comparePath, baseline)) return 2;
+
+    printf("threads=%u min-time=%.2f s repetitions=%d\n", resolveThreadCount(threads), minTime, repetitions);
+    printf("%-46s %13s %13s %11s %7s %12s", "benchmark (median)", "time ns", "cpu ns", "iterations", "cv", "items/s");
+    printf(comparePath ? " %13s %8s\n" : "\n", "baseline ns", "change");
+
+    std::vector<BenchResult> results;
+    for (const BenchCase &c : makeCases(threads)) {
+        if (filter && c.name.find(filter) == std::string::npos) continue;
+        BenchResult r = runCase(c, minTime, repetitions);
+        double cv = r.mean.realNs > 0.0 ? r.stddev.realNs / r.mean.realNs : 0.0;
+        printf("%-46s %13.0f %13.0f %11lld %6.1f%%", r.name.c_str(), r.median.realNs, r.median.cpuNs,
+               (long long)r.median.iterations, cv * 100.0);
+        if (r.items > 0.0) printf(" %11.3gM", r.items * 1e3 / r.median.realNs);
+        else printf(" %12s", "");
+        if (comparePath) {
+            auto it = baseline.find(r.name);
+            if (it != baseline.end() && it->second > 0.0)
+                printf(" %13.0f %+7.1f%%", it->second, (r.median.realNs / it->second - 1.0) * 100.0);
+            else
+                printf(" %13s %8s", "-", "new");
+        }
+        printf("\n");
+        fflush(stdout);
+        results.push_back(r);
+    }
+    if (results.empty()) {
+        fprintf(stderr, "no benchmark matches the filter\n");
+        return 2;
+    }
+    if (jsonPath && !writeJson(jsonPath, results, argv[0], resolveThreadCount(threads), repetitions)) return 2;
+    return 0;
+}
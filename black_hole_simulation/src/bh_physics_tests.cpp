@@ -0,0 +1,169 @@
+// bh_physics_tests.cpp
+// Regression tests of bh_physics run by ctest (no window, no GL). Each check prints one
+// line; the exit status is 1 if any failed.
+//   adaptive grid  - the incrementally updated tree gives the same mesh as a fresh build
+//                    at every radius of a zoom in and back out
+//   metric field   - float evaluateMetricField is bit-identical to the scalar functions,
+//                    for every thread count and a length that is not a lane multiple
+//   geodesic drift - E / L drift of bound orbits stays within bounds in each precision
+//   mesh threads   - ring / disk / BH pixel clouds hash the same for 1..8 threads
+
+#include "geodesic.hpp"
+#include "mesh_gen.hpp"
+#include "metric.hpp"
+#include "rng.hpp"
+#include "spacetime_grid.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void report(bool ok, const char *name, const char *detail) {
+    printf("%-4s %-28s %s\n", ok ? "ok" : "FAIL", name, detail);
+    if (!ok) ++failures;
+}
+
+bool sameGeometry(const GridGeometry &a, const GridGeometry &b) {
+    return a.verts.size() == b.verts.size() && a.indices.size() == b.indices.size() &&
+           memcmp(a.verts.data(), b.verts.data(), a.verts.size() * sizeof(GridVertex)) == 0 &&
+           memcmp(a.indices.data(), b.indices.data(), a.indices.size() * sizeof(unsigned int)) == 0;
+}
+
+void testAdaptiveGrid() {
+    // the scroll range of the renderer, in and back out
+    const float rFar = 40.0f, rNear = 0.5f;
+    const int zoomSteps = 60;
+    AdaptiveGrid ag;
+    updateAdaptiveGrid(ag, rFar);
+    int checked = 0, mismatches = 0;
+    for (int i = 1; i <= 2 * zoomSteps; ++i) {
+        float u = i <= zoomSteps ? float(i) / zoomSteps : float(2 * zoomSteps - i) / zoomSteps;
+        float radius = rFar * std::pow(rNear / rFar, u);
+        updateAdaptiveGrid(ag, radius);
+        AdaptiveGrid fresh;
+        updateAdaptiveGrid(fresh, radius);
+        ++checked;
+        if (!sameGeometry(ag.geometry, fresh.geometry)) {
+            if (mismatches == 0) fprintf(stderr, "adaptive grid: radius %.3f differs from a fresh build\n", radius);
+            ++mismatches;
+        }
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%d radii, %d differ from a fresh build", checked, mismatches);
+    report(mismatches == 0, "adaptive grid rebuild", detail);
+}
+
+void testMetricField() {
+    // 1003 points: not a multiple of any lane width, some inside the clamp radius
+    const size_t n = 1003;
+    const float rg = 0.35f, center[3] = {0.1f, -0.2f, 0.05f};
+    CounterRng rng(0x6d657472u);
+    std::vector<float> x(n), y(n), z(n), dist(n), distPlane(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = center[0] + 8.0f * rng.centered(3 * i);
+        y[i] = center[1] + 8.0f * rng.centered(3 * i + 1);
+        z[i] = center[2] + 8.0f * rng.centered(3 * i + 2);
+        if (i % 97 == 0) { x[i] = center[0]; y[i] = center[1]; z[i] = center[2]; }
+        float dx = x[i] - center[0], dy = y[i] - center[1], dz = z[i] - center[2];
+        dist[i] = std::sqrt(dx*dx + dy*dy + dz*dz);
+        distPlane[i] = std::sqrt(dx*dx + dy*dy);
+    }
+    int mismatches = 0;
+    for (MetricField field : {MetricField::TimeDilation, MetricField::SpatialDistortion}) {
+        auto scalar = [&](float r) {
+            return field == MetricField::TimeDilation ? computeTimeDilationFactor(rg, r)
+                                                      : computeSpatialDistortionApprox(rg, r);
+        };
+        for (unsigned threads : {1u, 3u, 8u}) {
+            std::vector<float> out(n), outPlane(n);
+            evaluateMetricField(field, rg, center, x.data(), y.data(), z.data(), out.data(), n, threads);
+            evaluateMetricField(field, rg, center, x.data(), y.data(), nullptr, outPlane.data(), n, threads);
+            for (size_t i = 0; i < n; ++i) {
+                float a = scalar(dist[i]), b = scalar(distPlane[i]);
+                if (memcmp(&out[i], &a, sizeof(float)) != 0 || memcmp(&outPlane[i], &b, sizeof(float)) != 0) {
+                    if (mismatches == 0)
+                        fprintf(stderr, "metric field %d, %u threads, point %zu: %.9g / %.9g vs scalar %.9g / %.9g\n",
+                                int(field), threads, i, out[i], outPlane[i], a, b);
+                    ++mismatches;
+                }
+            }
+        }
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "%zu points x 2 fields x 3 thread counts, %d differ", n, mismatches);
+    report(mismatches == 0, "metric field vs scalar", detail);
+}
+
+// Bounds leave 5-20x headroom over what the kernel gives at dτ = 0.02 (precision_bench)
+template <class P>
+void testGeodesicDrift(double maxE, double maxL) {
+    const size_t n = 1024;
+    GeodesicBatchT<P> b;
+    for (size_t i = 0; i < n; ++i) {
+        float u = (i + 0.5f) / float(n);
+        float r = 6.5f + 23.5f * u;
+        float incl = 0.6f * sinf(12.9898f * i);
+        float phase = 6.2831853f * fmodf(i * 0.618034f, 1.0f);
+        float speed = 0.97f + 0.03f * cosf(78.233f * i);
+        geodesicAddOrbit(b, r, incl, phase, speed);
+    }
+    geodesicStep(b, 0.02, 5000);
+    GeodesicDrift d = geodesicMeasureDrift(b);
+    // a few orbits close to 6.5M plunge; most must stay bound
+    bool ok = d.maxRelE <= maxE && d.maxRelL <= maxL && d.alive >= n * 9 / 10;
+    char name[32], detail[128];
+    snprintf(name, sizeof(name), "geodesic drift %s", P::name());
+    snprintf(detail, sizeof(detail), "max|dE/E| %.2e (<= %.0e), max|dL/L| %.2e (<= %.0e), %zu/%zu bound",
+             d.maxRelE, maxE, d.maxRelL, maxL, d.alive, n);
+    report(ok, name, detail);
+}
+
+void testMeshThreads() {
+    const uint64_t seed = 0x5eedb1ac4401eull;   // MESH_SEED in black_hole.cpp
+    struct Case {
+        const char *name;
+        void (*gen)(std::vector<Pixel>&, uint64_t, unsigned);
+    };
+    const Case cases[] = {
+        { "ring", [](std::vector<Pixel> &o, uint64_t s, unsigned t) { generatePhotonRingPixels(o, 0.52f, 0.6175f, 720 * 8, s, t); } },
+        { "disk", [](std::vector<Pixel> &o, uint64_t s, unsigned t) { generateDiskPixels(o, 0.5f, 0.95f, 0.04f, 36, 360 * 8, -0.28f, s, t); } },
+        { "bh",   [](std::vector<Pixel> &o, uint64_t, unsigned t) { generateBlackHolePixels(o, 300, 0.65f, t); } },
+    };
+    int mismatches = 0;
+    for (const Case &c : cases) {
+        std::vector<Pixel> serial;
+        c.gen(serial, seed, 1);
+        uint64_t ref = hashPixels(serial);
+        for (unsigned threads : {2u, 3u, 8u}) {
+            std::vector<Pixel> parallel;
+            c.gen(parallel, seed, threads);
+            if (parallel.size() != serial.size() || hashPixels(parallel) != ref) {
+                fprintf(stderr, "mesh %s: %u threads give %zu points hash %016llx, 1 thread %zu points hash %016llx\n",
+                        c.name, threads, parallel.size(), (unsigned long long)hashPixels(parallel), serial.size(),
+                        (unsigned long long)ref);
+                ++mismatches;
+            }
+        }
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "ring/disk/bh at 2, 3, 8 threads, %d differ from 1 thread", mismatches);
+    report(mismatches == 0, "mesh hash across threads", detail);
+}
+
+} // namespace
+
+int main() {
+    testAdaptiveGrid();
+    testMetricField();
+    testGeodesicDrift<FloatPrecision>(5e-4, 1e-4);
+    testGeodesicDrift<MixedPrecision>(5e-4, 1e-7);
+    testGeodesicDrift<DoublePrecision>(5e-4, 1e-12);
+    testMeshThreads();
+    printf(failures ? "%d check(s) failed\n" : "all checks passed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -20,15 +20,26 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "frame_pacing.hpp"
+#include "geodesic.hpp"
+#include "mesh_gen.hpp"
+#include "metric.hpp"
+#include "nbody.hpp"
+#include "photon_ring.hpp"
+#include "scene_config.hpp"
+#include "spacetime_grid.hpp"
+#include "text_mesh.hpp"
+
 #include <vector>
+#include <cstdint>
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
-#include <ctime>
 #include <cstring>
 #include <cstddef>
 #include <sstream>
 #include <iomanip>
+#include <string>
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -40,8 +51,45 @@ using namespace std;
 // ================ Scene / Tweak parameters ==============
 // ========================================================
 
-const int WIN_W = 800;
-const int WIN_H = 600;
+// Requested window size (scene file / --set), in screen coordinates
+int WINDOW_W = 800;
+int WINDOW_H = 600;
+// Framebuffer size in pixels: starts as the window size, then follows
+// framebuffer_size_cb (resizes, HiDPI scaling).
+int WIN_W = WINDOW_W;
+int WIN_H = WINDOW_H;
+bool framebufferResized = false;
+
+// Resolution of the star + lensing pass relative to the framebuffer ([ / ] change it).
+// Independent of the UI: grid, disk, BH and text always render at full resolution.
+float LENS_RENDER_SCALE = 1.0f;
+const float LENS_RENDER_SCALE_MIN = 0.5f;
+const float LENS_RENDER_SCALE_MAX = 2.0f;
+
+// Frame pacing: swap interval (Y cycles 0/1/2), optional frame cap on top of it
+// (L cycles), and the input-to-swap latency log written at exit with --latency-csv.
+int SWAP_INTERVAL = 1;
+double FRAME_RATE_CAP = 0.0;       // 0 = uncapped
+const double FRAME_RATE_CAPS[] = { 0.0, 30.0, 60.0, 120.0, 144.0 };
+string LATENCY_CSV;
+FramePacer framePacer;
+FrameLog frameLog;
+
+// Dynamic resolution (V toggles): scales the scene (grid/disk/BH) and lensing passes to
+// hold a GPU frame-time target; the result is upscaled to the framebuffer before the text.
+struct DynamicResolution {
+    bool enabled = false;
+    float targetMs = 16.6f;
+    float scale = 1.0f;              // multiplies both passes (the lensing pass keeps LENS_RENDER_SCALE on top)
+    float minScale = 0.5f, maxScale = 1.0f;
+    float step = 1.0f / 16.0f;       // scales are quantized so targets are reallocated rarely
+    float shrinkAbove = 1.05f;       // shrink when the smoothed time exceeds target * shrinkAbove
+    float growBelow = 0.80f;         // grow only below target * growBelow ...
+    float growPredictMax = 0.95f;    // ... and if the predicted time after growing stays under this
+    int cooldownFrames = 20;         // frames to wait after a change (timer results lag a few frames)
+    float smoothedMs = 0.0f;
+    int cooldown = 0;
+} dynRes;
 
 // Pixel resolution for the black hole (higher -> denser pixels)
 int BH_PIXEL_RES = 1000;        // can increase (256, 384...) if needed
@@ -60,10 +108,35 @@ float PH_RING_IN = BH_RADIUS * 0.8f;
 float PH_RING_OUT = BH_RADIUS * 0.95f;
 int PH_RING_SAMPLES = 720;
 
+// Photon ring from the Kerr critical curve (P toggles back to the point annulus above).
+// The curve is in units of M; its Schwarzschild radius 3*sqrt(3) M is mapped to the
+// middle of the annulus so both rings line up.
+float BH_SPIN = 0.0f;                  // a/M, J/K change it
+int PH_RING_ORDERS = 2;                // subrings n = 1..PH_RING_ORDERS
+float PH_RING_MIN_HALF_WIDTH = 0.08f;  // in M; thinner subrings are widened and dimmed to keep their flux
+float PH_RING_BRIGHTNESS = 8.0f;
+bool usePhotonRingStrip = true;
+
+// Seed of the jitter in the ring / disk point clouds (same picture on every run)
+uint64_t MESH_SEED = 0x5eedb1ac4401eull;
+
 // Stars
 struct Star { vec3 pos; vec3 color; float size; };
 vector<Star> stars;
 
+// N-body star cluster orbiting the hole (N toggles). Body 0 is the hole itself.
+int NBODY_COUNT = 4000;
+float NBODY_TIME_SCALE = 0.25f;    // simulated time per real second
+float NBODY_STAR_SIZE = 3.0f;
+bool nbodyEnabled = false;
+
+// Massive test particles on Schwarzschild geodesics (T toggles). Units of M inside the
+// integrator; M in scene units is half the Schwarzschild radius used by the diagnostics.
+int GEO_PARTICLES = 2048;
+float GEO_TIME_SCALE = 40.0f;      // proper time (in M) per real second
+float GEO_DTAU = 0.02f;            // leapfrog step (in M)
+bool geodesicsEnabled = false;
+
 // Camera
 struct Camera {
     float radius = 3.5f;
@@ -85,6 +158,9 @@ struct Camera {
 } camera;
 
 bool autoRotate = false;
+bool useAdaptiveGrid = true;   // G toggles quadtree grid vs uniform generateGrid
+int FIELD_OVERLAY = 0;         // H cycles the colormap on the grid: 0 off, 1 time dilation, 2 light deflection
+float FIELD_OVERLAY_ALPHA = 0.55f;
 
 // ============== Star-warp post-process parameters (GPU) ==============
 // Tweak to change how much the star rays curve
@@ -93,6 +169,114 @@ float STAR_WARP_FALLOFF = 2.0f;     // falloff exponent
 float BH_SCREEN_EFFECT_RADIUS = 0.22f; // normalized screen radius (0..1) around BH where effect is strong
 float STAR_RING_SHARPNESS = 8.0f;   // controls how ring-like the warped light becomes
 
+// ============== Scene file ==============
+// Every knob above can be set from a scene file (--scene, F5 reloads it) and from
+// --set KEY=VALUE; keys are the variable names. Changing a value marks what has to be
+// rebuilt, and the frame loop redoes only that.
+enum SceneDirtyBits : unsigned {
+    DIRTY_BH_PIXELS  = 1u << 0,
+    DIRTY_DISK       = 1u << 1,
+    DIRTY_RING_CLOUD = 1u << 2,   // point annulus
+    DIRTY_RING_STRIP = 1u << 3,   // subring instances of the critical curve strip
+    DIRTY_NBODY      = 1u << 4,
+    DIRTY_GEODESICS  = 1u << 5,
+    DIRTY_WINDOW     = 1u << 6,
+    DIRTY_PACING     = 1u << 7,
+};
+SceneConfig sceneConfig;
+unsigned sceneDirty = 0;
+string SCENE_FILE;
+vector<string> SCENE_OVERRIDES;    // --set arguments, re-applied after every reload
+int RUN_FRAMES = 0;                // > 0: render that many frames, print a RESULT line and exit
+
+void bindSceneParams(SceneConfig &c) {
+    sceneBind(c, "WINDOW_W", WINDOW_W, DIRTY_WINDOW);
+    sceneBind(c, "WINDOW_H", WINDOW_H, DIRTY_WINDOW);
+    sceneBind(c, "LENS_RENDER_SCALE", LENS_RENDER_SCALE);
+    sceneBind(c, "SWAP_INTERVAL", SWAP_INTERVAL, DIRTY_PACING);
+    sceneBind(c, "FRAME_RATE_CAP", FRAME_RATE_CAP, DIRTY_PACING);
+    sceneBind(c, "LATENCY_CSV", LATENCY_CSV);
+    sceneBind(c, "RUN_FRAMES", RUN_FRAMES);
+    sceneBind(c, "dynRes.enabled", dynRes.enabled);
+    sceneBind(c, "dynRes.targetMs", dynRes.targetMs);
+    sceneBind(c, "dynRes.minScale", dynRes.minScale);
+    sceneBind(c, "dynRes.maxScale", dynRes.maxScale);
+    sceneBind(c, "BH_PIXEL_RES", BH_PIXEL_RES, DIRTY_BH_PIXELS);
+    sceneBind(c, "BH_RADIUS", BH_RADIUS, DIRTY_BH_PIXELS);
+    sceneBind(c, "pixelPointSize", pixelPointSize);
+    sceneBind(c, "DISK_RADIAL_STEPS", DISK_RADIAL_STEPS, DIRTY_DISK);
+    sceneBind(c, "DISK_ANGULAR_STEPS", DISK_ANGULAR_STEPS, DIRTY_DISK);
+    sceneBind(c, "DISK_INNER", DISK_INNER, DIRTY_DISK);
+    sceneBind(c, "DISK_OUTER", DISK_OUTER, DIRTY_DISK);
+    sceneBind(c, "DISK_THICKNESS", DISK_THICKNESS, DIRTY_DISK);
+    sceneBind(c, "PH_RING_IN", PH_RING_IN, DIRTY_RING_CLOUD);
+    sceneBind(c, "PH_RING_OUT", PH_RING_OUT, DIRTY_RING_CLOUD);
+    sceneBind(c, "PH_RING_SAMPLES", PH_RING_SAMPLES, DIRTY_RING_CLOUD);
+    sceneBind(c, "BH_SPIN", BH_SPIN);
+    sceneBind(c, "PH_RING_ORDERS", PH_RING_ORDERS, DIRTY_RING_STRIP);
+    sceneBind(c, "PH_RING_MIN_HALF_WIDTH", PH_RING_MIN_HALF_WIDTH);
+    sceneBind(c, "PH_RING_BRIGHTNESS", PH_RING_BRIGHTNESS, DIRTY_RING_STRIP);
+    sceneBind(c, "usePhotonRingStrip", usePhotonRingStrip);
+    sceneBind(c, "MESH_SEED", MESH_SEED, DIRTY_DISK | DIRTY_RING_CLOUD);
+    sceneBind(c, "NBODY_COUNT", NBODY_COUNT, DIRTY_NBODY);
+    sceneBind(c, "NBODY_TIME_SCALE", NBODY_TIME_SCALE);
+    sceneBind(c, "NBODY_STAR_SIZE", NBODY_STAR_SIZE);
+    sceneBind(c, "nbodyEnabled", nbodyEnabled);
+    sceneBind(c, "GEO_PARTICLES", GEO_PARTICLES, DIRTY_GEODESICS);
+    sceneBind(c, "GEO_TIME_SCALE", GEO_TIME_SCALE);
+    sceneBind(c, "GEO_DTAU", GEO_DTAU);
+    sceneBind(c, "geodesicsEnabled", geodesicsEnabled);
+    sceneBind(c, "camera.radius", camera.radius);
+    sceneBind(c, "camera.azimuth", camera.azimuth);
+    sceneBind(c, "camera.elevation", camera.elevation);
+    sceneBind(c, "autoRotate", autoRotate);
+    sceneBind(c, "useAdaptiveGrid", useAdaptiveGrid);
+    sceneBind(c, "FIELD_OVERLAY", FIELD_OVERLAY);
+    sceneBind(c, "FIELD_OVERLAY_ALPHA", FIELD_OVERLAY_ALPHA);
+    sceneBind(c, "STAR_WARP_STRENGTH", STAR_WARP_STRENGTH);
+    sceneBind(c, "STAR_WARP_FALLOFF", STAR_WARP_FALLOFF);
+    sceneBind(c, "BH_SCREEN_EFFECT_RADIUS", BH_SCREEN_EFFECT_RADIUS);
+    sceneBind(c, "STAR_RING_SHARPNESS", STAR_RING_SHARPNESS);
+}
+
+// Keeps loaded values inside the ranges the renderer (and the keys) assume
+static void clampSceneParams() {
+    WINDOW_W = glm::max(WINDOW_W, 1);
+    WINDOW_H = glm::max(WINDOW_H, 1);
+    LENS_RENDER_SCALE = glm::clamp(LENS_RENDER_SCALE, LENS_RENDER_SCALE_MIN, LENS_RENDER_SCALE_MAX);
+    SWAP_INTERVAL = glm::max(SWAP_INTERVAL, 0);
+    FRAME_RATE_CAP = glm::max(FRAME_RATE_CAP, 0.0);
+    BH_PIXEL_RES = glm::clamp(BH_PIXEL_RES, 16, 1024);
+    DISK_RADIAL_STEPS = glm::max(DISK_RADIAL_STEPS, 1);
+    DISK_ANGULAR_STEPS = glm::max(DISK_ANGULAR_STEPS, 1);
+    PH_RING_SAMPLES = glm::max(PH_RING_SAMPLES, 1);
+    BH_SPIN = glm::clamp(BH_SPIN, 0.0f, 0.99f);
+    PH_RING_ORDERS = glm::clamp(PH_RING_ORDERS, 1, 8);
+    NBODY_COUNT = glm::max(NBODY_COUNT, 1);
+    GEO_PARTICLES = glm::max(GEO_PARTICLES, 1);
+    GEO_DTAU = glm::max(GEO_DTAU, 1e-4f);
+    FIELD_OVERLAY = glm::clamp(FIELD_OVERLAY, 0, 2);
+    FIELD_OVERLAY_ALPHA = glm::clamp(FIELD_OVERLAY_ALPHA, 0.0f, 1.0f);
+}
+
+// Loads SCENE_FILE (if any), then the --set overrides on top; reports every bad line
+bool applySceneSources() {
+    bool ok = true;
+    string error;
+    if (!SCENE_FILE.empty() && !sceneLoadFile(sceneConfig, SCENE_FILE, sceneDirty, error)) {
+        cerr << error << endl;
+        ok = false;
+    }
+    for (const string &o : SCENE_OVERRIDES) {
+        if (!sceneSetAssignment(sceneConfig, o, sceneDirty, error)) {
+            cerr << "--set " << error << endl;
+            ok = false;
+        }
+    }
+    clampSceneParams();
+    return ok;
+}
+
 // ========================================================
 // ================= Shader helpers =======================
 // ========================================================
@@ -136,17 +320,16 @@ static GLuint linkProgram(GLuint vs, GLuint fs) {
 // ================= Geometry / mesh utils =================
 // ========================================================
 
-struct Pixel {
-    float x,y,z;
-    float r,g,b,a;
-};
 struct MeshBuffer {
     vector<Pixel> pixels;
     GLuint vao=0, vbo=0;
     int count=0;
 };
 
-struct GridMesh { vector<vec3> verts; vector<unsigned int> indices; GLuint vao=0,vbo=0,ebo=0; int indexCount=0; };
+// Offscreen color target (+ optional depth), reallocated only when its size changes
+struct RenderTarget { GLuint fbo=0, tex=0, rbo=0; int w=0, h=0; bool depth=false; };
+
+struct GridMesh { GLuint vao=0,vbo=0,ebo=0; int indexCount=0; size_t vertCount=0; };
 
 // Billboard helper (same as you used before)
 mat4 makeBillboardModel(const vec3 &pos, const vec3 &camPos, float scale){
@@ -163,118 +346,93 @@ mat4 makeBillboardModel(const vec3 &pos, const vec3 &camPos, float scale){
 }
 
 // ========================================================
-// ================= Mesh generation =======================
+// ================= Grid upload ===========================
 // ========================================================
 
-// Black hole interior pixels (billboard local)
-void generateBlackHolePixels(MeshBuffer &mb, int res, float radius) {
-    mb.pixels.clear();
-    for (int j=0;j<res;++j){
-        for (int i=0;i<res;++i){
-            float u = (i + 0.5f)/float(res)*2.0f - 1.0f;
-            float v = (j + 0.5f)/float(res)*2.0f - 1.0f;
-            float x = u * radius;
-            float y = v * radius;
-            float r = sqrt(x*x + y*y);
-            if (r <= radius) {
-                Pixel p;
-                p.x = x; p.y = y; p.z = 0.01f;
-                p.r = 0.0f; p.g = 0.0f; p.b = 0.0f; p.a = 1.0f;
-                mb.pixels.push_back(p);
-            }
-        }
-    }
-    mb.count = (int)mb.pixels.size();
+// Grid geometry (uniform or adaptive) is built in spacetime_grid.cpp
+void uploadGridMesh(GridMesh &m, const GridGeometry &g) {
+    m.indexCount = (int)g.indices.size();
+    m.vertCount = g.verts.size();
+    if (!m.vao) glGenVertexArrays(1, &m.vao);
+    if (!m.vbo) glGenBuffers(1, &m.vbo);
+    if (!m.ebo) glGenBuffers(1, &m.ebo);
+    glBindVertexArray(m.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
+    glBufferData(GL_ARRAY_BUFFER, g.verts.size()*sizeof(GridVertex), g.verts.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(GridVertex),(void*)0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, g.indices.size()*sizeof(unsigned int), g.indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
 }
 
-// Photon ring (billboard-local)
-void generatePhotonRingBillboard(MeshBuffer &mb, float inR, float outR, int samples) {
-    mb.pixels.clear();
-    float radialStep = (outR - inR) / 6.0f;
-    for (int s=0;s<samples;++s){
-        float a = (s + 0.5f)/float(samples) * 2.0f * M_PI;
-        for (float r = inR; r <= outR; r += radialStep){
-            float jitter = ((rand()%1000)/1000.0f - 0.5f) * 0.004f;
-            float rr = r + jitter;
-            Pixel p;
-            p.x = cos(a) * rr;
-            p.y = sin(a) * rr;
-            p.z = 0.0f;
-            float tt = (rr - inR) / (outR - inR);
-            vec3 col = mix(vec3(1.0f, 0.55f, 0.08f), vec3(1.0f, 0.12f, 0.02f), tt);
-            float alpha = 0.95f * (0.6f + 0.6f * (1.0f - abs(tt - 0.5f)));
-            p.r = col.r; p.g = col.g; p.b = col.b; p.a = alpha;
-            mb.pixels.push_back(p);
-        }
-    }
-    mb.count = (int)mb.pixels.size();
+// Grid for background (Schwarzschild-like)
+void generateGrid(GridMesh &m, int gridSize=28, float spacing=0.12f, float massScale=3.2f) {
+    GridGeometry g;
+    generateGridGeometry(g, gridSize, spacing, massScale);
+    uploadGridMesh(m, g);
 }
 
-// Disk pixels in world coordinates (horizontal)
-void generateDiskPixelsWorld(MeshBuffer &mb, float innerR, float outerR, float thickness, int radialSteps, int angularSteps, float blackY) {
-    mb.pixels.clear();
-    for (int ri=0; ri<radialSteps; ++ri){
-        float t = (ri+0.5f)/float(radialSteps);
-        float r = mix(innerR, outerR, t);
-        int aSteps = angularSteps;
-        for (int ai=0; ai<aSteps; ++ai){
-            float a = (ai + 0.5f)/float(aSteps) * 2.0f * M_PI;
-            float jitter = ((rand()%1000)/1000.0f - 0.5f) * 0.003f;
-            float rr = r + jitter;
-            for (int yi=0; yi<3; ++yi) {
-                float y = blackY + (-thickness*0.35f + yi * (thickness*0.35f));
-                Pixel p;
-                p.x = cos(a)*rr;
-                p.z = sin(a)*rr;
-                p.y = y;
-                float radialNorm = smoothstep(innerR, outerR, rr);
-                vec3 innerColor = vec3(0.96f, 0.12f, 0.03f);
-                vec3 outerColor = vec3(1.0f, 0.78f, 0.18f);
-                vec3 col = mix(innerColor, outerColor, radialNorm);
-                float alpha = 0.92f * (0.6f + 0.6f*radialNorm);
-                p.r = col.r; p.g = col.g; p.b = col.b; p.a = alpha;
-                mb.pixels.push_back(p);
-            }
-        }
-    }
-    mb.count = (int)mb.pixels.size();
-}
+// ========================================================
+// ================= Field overlay =========================
+// ========================================================
 
-// Grid for background (Schwarzschild-like)
-void generateGrid(GridMesh &g, int gridSize=28, float spacing=0.12f, float massScale=3.2f) {
-    g.verts.clear(); g.indices.clear();
-    int N = gridSize*2 + 1;
-    for (int z=-gridSize; z<=gridSize; ++z){
-        for (int x=-gridSize; x<=gridSize; ++x){
-            float fx = x * spacing;
-            float fz = z * spacing;
-            float r = sqrt(fx*fx + fz*fz);
-            float A = 0.45f * massScale;
-            float fy = -A / (r + 0.08f) * exp(-r*0.6f);
-            g.verts.emplace_back(fx, fy - 0.28f, fz);
-        }
-    }
-    for (int z=0; z<N; ++z){
-        for (int x=0; x<N; ++x){
-            int i = z*N + x;
-            if (x < N-1) { g.indices.push_back(i); g.indices.push_back(i+1); }
-            if (z < N-1) { g.indices.push_back(i); g.indices.push_back(i+N); }
-        }
-    }
-    g.indexCount = (int)g.indices.size();
-    if (!g.vao) glGenVertexArrays(1, &g.vao);
-    if (!g.vbo) glGenBuffers(1, &g.vbo);
-    if (!g.ebo) glGenBuffers(1, &g.ebo);
-    glBindVertexArray(g.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, g.vbo);
-    glBufferData(GL_ARRAY_BUFFER, g.verts.size()*sizeof(vec3), g.verts.data(), GL_STATIC_DRAW);
+// Filled grid surface colored by a metric field (FIELD_OVERLAY). The values are
+// evaluated per vertex with evaluateMetricField, only when the field or rg changes.
+struct FieldOverlay {
+    vector<float> x, y, z, values;    // surface vertices, SoA for the field API
+    GLuint vao=0, vboPos=0, vboVal=0, ebo=0;
+    int indexCount = 0;
+    int field = 0;                    // FIELD_OVERLAY the values hold
+    float rg = -1.0f;
+};
+
+void setupFieldOverlay(FieldOverlay &fo) {
+    // footprint of generateGrid(28, 0.12), 4.5x finer so the colormap is smooth
+    GridGeometry g;
+    generateGridSurface(g, 128, 3.36f / 128, 3.2f);
+    size_t n = g.verts.size();
+    fo.x.resize(n); fo.y.resize(n); fo.z.resize(n); fo.values.assign(n, 0.0f);
+    for (size_t i = 0; i < n; ++i) { fo.x[i] = g.verts[i].x; fo.y[i] = g.verts[i].y; fo.z[i] = g.verts[i].z; }
+    fo.indexCount = (int)g.indices.size();
+
+    glGenVertexArrays(1, &fo.vao);
+    glGenBuffers(1, &fo.vboPos);
+    glGenBuffers(1, &fo.vboVal);
+    glGenBuffers(1, &fo.ebo);
+    glBindVertexArray(fo.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, fo.vboPos);
+    glBufferData(GL_ARRAY_BUFFER, n*sizeof(GridVertex), g.verts.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(vec3),(void*)0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g.ebo);
+    glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(GridVertex),(void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, fo.vboVal);
+    glBufferData(GL_ARRAY_BUFFER, n*sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1,1,GL_FLOAT,GL_FALSE,sizeof(float),(void*)0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, fo.ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, g.indices.size()*sizeof(unsigned int), g.indices.data(), GL_STATIC_DRAW);
     glBindVertexArray(0);
 }
 
+void updateFieldOverlay(FieldOverlay &fo, int field, float rg, const vec3 &center) {
+    if (field == fo.field && rg == fo.rg) return;
+    fo.field = field;
+    fo.rg = rg;
+    const float c[3] = { center.x, center.y, center.z };
+    MetricField f = field == 1 ? MetricField::TimeDilation : MetricField::SpatialDistortion;
+    evaluateMetricField(f, rg, c, fo.x.data(), fo.y.data(), fo.z.data(), fo.values.data(), fo.values.size());
+    glBindBuffer(GL_ARRAY_BUFFER, fo.vboVal);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, fo.values.size()*sizeof(float), fo.values.data());
+}
+
+void destroyFieldOverlay(FieldOverlay &fo) {
+    if (fo.vao) glDeleteVertexArrays(1, &fo.vao);
+    if (fo.vboPos) glDeleteBuffers(1, &fo.vboPos);
+    if (fo.vboVal) glDeleteBuffers(1, &fo.vboVal);
+    if (fo.ebo) glDeleteBuffers(1, &fo.ebo);
+    fo = FieldOverlay();
+}
+
 // Stars setup
 void setupStars() {
     stars.clear();
@@ -283,32 +441,222 @@ void setupStars() {
     stars.push_back({ vec3( 4.2f, 0.7f, -8.3f), vec3(1.0f, 0.18f, 0.08f), 84.0f });
 }
 
+// Test particles: stable precessing orbits outside the ISCO plus a few inside it that plunge
+void setupGeodesicParticles(GeodesicBatch &b, int count) {
+    b = GeodesicBatch();
+    b.kind = GeodesicKind::Timelike;
+    b.M = 1.0f;
+    for (int i = 0; i < count; ++i) {
+        float u = (i + 0.5f) / float(count);
+        bool plunging = (i % 16) == 0;
+        float r = plunging ? 4.5f + 1.4f * u : 6.5f + 7.5f * u;
+        float incl = 0.5f * sin(12.9898f * i);
+        float phase = 2.0f * float(M_PI) * fract(i * 0.618034f);
+        float speed = plunging ? 1.0f : 0.96f + 0.04f * cos(78.233f * i);
+        geodesicAddOrbit(b, r, incl, phase, speed);
+    }
+}
+
+void geodesicsToPixels(const GeodesicBatch &b, const vec3 &center, float sceneM, vector<Pixel> &out) {
+    out.clear();
+    out.reserve(b.count);
+    for (size_t i = 0; i < b.count; ++i) {
+        if (b.alive[i] < 0.5f) continue;
+        float r = sqrt(b.x[i]*b.x[i] + b.y[i]*b.y[i] + b.z[i]*b.z[i]);
+        vec3 col = mix(vec3(0.55f, 0.8f, 1.0f), vec3(1.0f, 0.95f, 0.85f), smoothstep(4.0f, 14.0f, r));
+        vec3 p = center + vec3(b.x[i], b.y[i], b.z[i]) * sceneM;
+        out.push_back({ p.x, p.y, p.z, col.r, col.g, col.b, 0.9f });
+    }
+}
+
 // ========================================================
 // ================= Upload helpers =======================
 // ========================================================
 
+// layout 0: vec3 pos, 1: vec4 color (VAO and VBO bound)
+void setPixelAttribs() {
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(Pixel),(void*)offsetof(Pixel,x));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1,4,GL_FLOAT,GL_FALSE,sizeof(Pixel),(void*)offsetof(Pixel,r));
+}
+
 void uploadMesh(MeshBuffer &mb) {
     if (!mb.vao) glGenVertexArrays(1, &mb.vao);
     if (!mb.vbo) glGenBuffers(1, &mb.vbo);
     glBindVertexArray(mb.vao);
     glBindBuffer(GL_ARRAY_BUFFER, mb.vbo);
     glBufferData(GL_ARRAY_BUFFER, mb.pixels.size()*sizeof(Pixel), mb.pixels.data(), GL_STATIC_DRAW);
-    // layout 0: vec3 pos, 1: vec4 color
+    setPixelAttribs();
+    glBindVertexArray(0);
+}
+
+// Sizes mb.vbo for `count` pixels and lets fill(Pixel*) write them straight into the
+// mapped buffer, so no CPU-side copy is kept (mb.pixels stays empty). Falls back to a
+// temporary vector if the mapping fails or the driver reports the store as lost.
+template <class Fill>
+void uploadMeshMapped(MeshBuffer &mb, size_t count, Fill &&fill) {
+    if (!mb.vao) glGenVertexArrays(1, &mb.vao);
+    if (!mb.vbo) glGenBuffers(1, &mb.vbo);
+    vector<Pixel>().swap(mb.pixels);
+    glBindVertexArray(mb.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, mb.vbo);
+    GLsizeiptr bytes = GLsizeiptr(count * sizeof(Pixel));
+    glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STATIC_DRAW);
+    if (bytes > 0) {
+        void *dst = glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        bool stored = false;
+        if (dst) {
+            fill(static_cast<Pixel*>(dst));
+            stored = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+        }
+        if (!stored) {
+            vector<Pixel> tmp(count);
+            fill(tmp.data());
+            glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, tmp.data());
+        }
+    }
+    setPixelAttribs();
+    glBindVertexArray(0);
+    mb.count = (int)count;
+}
+
+// Static point clouds, generated in parallel straight into their VBOs (see mesh_gen.hpp)
+
+// Black hole interior pixels (billboard local)
+void generateBlackHolePixels(MeshBuffer &mb, int res, float radius) {
+    BlackHolePixelLayout layout;
+    blackHolePixelLayout(layout, res, radius);
+    uploadMeshMapped(mb, layout.count, [&](Pixel *dst) { fillBlackHolePixels(dst, layout); });
+}
+
+// Photon ring (billboard-local)
+void generatePhotonRingBillboard(MeshBuffer &mb, float inR, float outR, int samples) {
+    uploadMeshMapped(mb, photonRingPixelCount(samples), [&](Pixel *dst) {
+        fillPhotonRingPixels(dst, inR, outR, samples, MESH_SEED);
+    });
+}
+
+// Disk pixels in world coordinates (horizontal)
+void generateDiskPixelsWorld(MeshBuffer &mb, float innerR, float outerR, float thickness, int radialSteps, int angularSteps, float blackY) {
+    uploadMeshMapped(mb, diskPixelCount(radialSteps, angularSteps), [&](Pixel *dst) {
+        fillDiskPixels(dst, innerR, outerR, thickness, radialSteps, angularSteps, blackY, MESH_SEED);
+    });
+}
+
+// (Re)allocates rt's storage if the requested size differs; returns true when it did.
+bool ensureRenderTarget(RenderTarget &rt, int w, int h, bool depth) {
+    w = glm::max(w, 1); h = glm::max(h, 1);
+    if (rt.fbo && rt.w == w && rt.h == h && rt.depth == depth) return false;
+    if (!rt.fbo) glGenFramebuffers(1, &rt.fbo);
+    if (!rt.tex) glGenTextures(1, &rt.tex);
+    glBindFramebuffer(GL_FRAMEBUFFER, rt.fbo);
+    glBindTexture(GL_TEXTURE_2D, rt.tex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, rt.tex, 0);
+    if (depth) {
+        if (!rt.rbo) glGenRenderbuffers(1, &rt.rbo);
+        glBindRenderbuffer(GL_RENDERBUFFER, rt.rbo);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rt.rbo);
+    } else if (rt.rbo) {
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, 0);
+        glDeleteRenderbuffers(1, &rt.rbo);
+        rt.rbo = 0;
+    }
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        cerr << "Render target " << w << "x" << h << " incomplete\n";
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    rt.w = w; rt.h = h; rt.depth = depth;
+    return true;
+}
+
+void destroyRenderTarget(RenderTarget &rt) {
+    if (rt.fbo) glDeleteFramebuffers(1, &rt.fbo);
+    if (rt.tex) glDeleteTextures(1, &rt.tex);
+    if (rt.rbo) glDeleteRenderbuffers(1, &rt.rbo);
+    rt = RenderTarget();
+}
+
+// Feeds one GPU frame time into the controller. Cost is taken as proportional to the
+// pixel count (scale^2): shrinking jumps straight to the scale predicted to meet the
+// target, growing goes one step at a time. The band between growBelow and shrinkAbove,
+// the growth prediction and the cooldown keep it from oscillating.
+void updateDynamicResolution(DynamicResolution &dr, float gpuMs) {
+    if (!dr.enabled) { dr.scale = 1.0f; dr.smoothedMs = 0.0f; dr.cooldown = 0; return; }
+    dr.smoothedMs = (dr.smoothedMs <= 0.0f) ? gpuMs : glm::mix(dr.smoothedMs, gpuMs, 0.1f);
+    if (dr.cooldown > 0) { --dr.cooldown; return; }
+
+    float next = dr.scale;
+    if (dr.smoothedMs > dr.targetMs * dr.shrinkAbove) {
+        float want = dr.scale * sqrt(dr.targetMs / dr.smoothedMs);
+        next = glm::min(dr.scale - dr.step, floor(want / dr.step) * dr.step);
+    } else if (dr.smoothedMs < dr.targetMs * dr.growBelow) {
+        float grown = dr.scale + dr.step;
+        float predicted = dr.smoothedMs * (grown * grown) / (dr.scale * dr.scale);
+        if (predicted < dr.targetMs * dr.growPredictMax) next = grown;
+    }
+    next = clamp(next, dr.minScale, dr.maxScale);
+    if (next != dr.scale) {
+        dr.smoothedMs *= (next * next) / (dr.scale * dr.scale);
+        dr.scale = next;
+        dr.cooldown = dr.cooldownFrames;
+    }
+}
+
+// Photon ring strip: 2 vertices per curve point (closed), plus one instance per subring
+struct PhotonRingStrip {
+    GLuint vao=0, vbo=0, instanceVbo=0;
+    int vertexCount=0, instanceCount=0;
+    uint32_t key=0xffffffffu;   // PhotonRingCache key of the uploaded curve
+};
+void uploadPhotonRingStrip(PhotonRingStrip &rs, const PhotonRingCurve &curve, const vector<PhotonSubring> &subrings) {
+    struct RingVertex { float x,y,nx,ny,lyap,side; };
+    vector<RingVertex> verts;
+    size_t n = curve.alpha.size();
+    verts.reserve(2 * (n + 1));
+    for (size_t k = 0; k <= n; ++k) {
+        size_t i = k % n;
+        for (float side : { -1.0f, 1.0f })
+            verts.push_back({ curve.alpha[i], curve.beta[i], curve.nx[i], curve.ny[i], curve.lyapunov[i], side });
+    }
+    if (!rs.vao) glGenVertexArrays(1, &rs.vao);
+    if (!rs.vbo) glGenBuffers(1, &rs.vbo);
+    if (!rs.instanceVbo) glGenBuffers(1, &rs.instanceVbo);
+    glBindVertexArray(rs.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, rs.vbo);
+    glBufferData(GL_ARRAY_BUFFER, verts.size()*sizeof(RingVertex), verts.data(), GL_STATIC_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(Pixel),(void*)offsetof(Pixel,x));
+    glVertexAttribPointer(0,2,GL_FLOAT,GL_FALSE,sizeof(RingVertex),(void*)offsetof(RingVertex,x));
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1,4,GL_FLOAT,GL_FALSE,sizeof(Pixel),(void*)offsetof(Pixel,r));
+    glVertexAttribPointer(1,2,GL_FLOAT,GL_FALSE,sizeof(RingVertex),(void*)offsetof(RingVertex,nx));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2,1,GL_FLOAT,GL_FALSE,sizeof(RingVertex),(void*)offsetof(RingVertex,lyap));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3,1,GL_FLOAT,GL_FALSE,sizeof(RingVertex),(void*)offsetof(RingVertex,side));
+    glBindBuffer(GL_ARRAY_BUFFER, rs.instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, subrings.size()*sizeof(PhotonSubring), subrings.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4,4,GL_FLOAT,GL_FALSE,sizeof(PhotonSubring),(void*)0);
+    glVertexAttribDivisor(4, 1);
     glBindVertexArray(0);
+    rs.vertexCount = (int)verts.size();
+    rs.instanceCount = (int)subrings.size();
 }
 
 // Stars upload (separate layout)
 GLuint starsVAO = 0, starsVBO = 0;
-void uploadStars() {
-    if(!starsVAO) glGenVertexArrays(1, &starsVAO);
-    if(!starsVBO) glGenBuffers(1, &starsVBO);
-    glBindVertexArray(starsVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, starsVBO);
-    glBufferData(GL_ARRAY_BUFFER, stars.size()*sizeof(Star), stars.data(), GL_STATIC_DRAW);
+void uploadStarBuffer(GLuint &vao, GLuint &vbo, const vector<Star> &list, GLenum usage) {
+    if(!vao) glGenVertexArrays(1, &vao);
+    if(!vbo) glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, list.size()*sizeof(Star), list.data(), usage);
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,sizeof(Star),(void*)offsetof(Star,pos));
     glEnableVertexAttribArray(1);
@@ -317,6 +665,19 @@ void uploadStars() {
     glVertexAttribPointer(2,1,GL_FLOAT,GL_FALSE,sizeof(Star),(void*)offsetof(Star,size));
     glBindVertexArray(0);
 }
+void uploadStars() { uploadStarBuffer(starsVAO, starsVBO, stars, GL_STATIC_DRAW); }
+
+// N-body bodies -> star sprites (skips body 0, the hole), tinted by speed
+void nbodyToStars(const NBodySystem &s, const vec3 &center, vector<Star> &out) {
+    out.clear();
+    out.reserve(s.size());
+    for (size_t i = 1; i < s.size(); ++i) {
+        float v = sqrt(s.vx[i]*s.vx[i] + s.vy[i]*s.vy[i] + s.vz[i]*s.vz[i]);
+        float t = clamp(v * 1.2f - 0.3f, 0.0f, 1.0f);
+        vec3 col = mix(vec3(1.0f, 0.35f, 0.12f), vec3(1.0f, 0.85f, 0.6f), t);
+        out.push_back({ center + vec3(s.x[i], s.y[i], s.z[i]), col, NBODY_STAR_SIZE });
+    }
+}
 
 // ========================================================
 // ================= Shaders sources =======================
@@ -336,6 +697,38 @@ out vec4 FragColor;
 void main(){ FragColor = vec4(0.95,0.7,0.45,1.0); }
 )GLSL";
 
+// Field overlay: grid surface with one field value per vertex, mapped through a colormap
+const char* vs_field = R"GLSL(
+#version 330 core
+layout(location=0) in vec3 aPos;
+layout(location=1) in float aValue;
+uniform mat4 uMVP;
+out float vValue;
+void main(){ vValue = aValue; gl_Position = uMVP * vec4(aPos,1.0); }
+)GLSL";
+
+const char* fs_field = R"GLSL(
+#version 330 core
+in float vValue;
+uniform float uInvert;   // 1: low values are hot (time dilation factor -> 0 at the horizon)
+uniform float uAlpha;
+out vec4 FragColor;
+// dark blue -> purple -> red -> orange -> pale yellow
+vec3 colormap(float t){
+    const vec3 c0 = vec3(0.02,0.02,0.10), c1 = vec3(0.35,0.05,0.45), c2 = vec3(0.80,0.15,0.25);
+    const vec3 c3 = vec3(0.98,0.55,0.10), c4 = vec3(1.00,0.95,0.70);
+    t = clamp(t, 0.0, 1.0) * 4.0;
+    if (t < 1.0) return mix(c0, c1, t);
+    if (t < 2.0) return mix(c1, c2, t - 1.0);
+    if (t < 3.0) return mix(c2, c3, t - 2.0);
+    return mix(c3, c4, t - 3.0);
+}
+void main(){
+    float t = mix(vValue, 1.0 - vValue, uInvert);
+    FragColor = vec4(colormap(t), uAlpha);
+}
+)GLSL";
+
 // Points (pixels) shader: input vec3 pos, vec4 color
 const char* vs_points = R"GLSL(
 #version 330 core
@@ -361,6 +754,33 @@ void main(){
 }
 )GLSL";
 
+// Photon subrings: one triangle strip along the critical curve, one instance per order n.
+// Offset and width shrink as e^(-gamma n); alpha keeps the flux of strips drawn wider than
+// their true width. Uses fs_points.
+const char* vs_ring = R"GLSL(
+#version 330 core
+layout(location=0) in vec2 aPos;      // critical curve point (units of M)
+layout(location=1) in vec2 aNormal;   // outward normal
+layout(location=2) in float aLyap;    // Lyapunov exponent gamma
+layout(location=3) in float aSide;    // -1 inner edge, +1 outer edge
+layout(location=4) in vec4 aSub;      // per instance: n, offset scale, width scale, brightness
+uniform mat4 uMVP;
+uniform float uUnitsPerM;
+uniform float uMinHalfWidth;
+out vec4 vCol;
+void main(){
+    float n = aSub.x;
+    float b = length(aPos);
+    float decay = exp(-aLyap * n);
+    float halfWidth = aSub.z * b * decay;
+    float drawn = max(halfWidth, uMinHalfWidth);
+    vec2 p = aPos + aNormal * (aSub.y * b * decay + aSide * drawn);
+    vec3 col = mix(vec3(1.0, 0.55, 0.08), vec3(1.0, 0.12, 0.02), clamp(n - 1.0, 0.0, 1.0));
+    vCol = vec4(col, clamp(aSub.w * halfWidth / drawn, 0.0, 1.0));
+    gl_Position = uMVP * vec4(p * uUnitsPerM, 0.0, 1.0);
+}
+)GLSL";
+
 // Stars vertex/fragment (point sprites, gaussian blur)
 const char* vs_star = R"GLSL(
 #version 330 core
@@ -368,13 +788,14 @@ layout(location=0) in vec3 aPos;
 layout(location=1) in vec3 aColor;
 layout(location=2) in float aSize;
 uniform mat4 uMVP;
+uniform float uSizeScale;   // target width / framebuffer width: same sprite size on screen
 out vec3 vColor;
 out float vSize;
 void main(){
     vColor = aColor;
     vSize = aSize;
     gl_Position = uMVP * vec4(aPos,1.0);
-    gl_PointSize = aSize;
+    gl_PointSize = aSize * uSizeScale;
 }
 )GLSL";
 
@@ -406,6 +827,15 @@ void main(){
 }
 )GLSL";
 
+// Composites a lower/higher resolution layer onto the framebuffer (bilinear)
+const char* fs_blit = R"GLSL(
+#version 330 core
+in vec2 vUV;
+out vec4 FragColor;
+uniform sampler2D uTex;
+void main(){ FragColor = texture(uTex, vUV); }
+)GLSL";
+
 // Postprocess fragment: warp star texture by BH-screen position
 // Approach (approximate, artistic):
 // - compute vector from current fragment uv to BH screen uv
@@ -479,324 +909,6 @@ void main(){
 }
 )GLSL";
 
-// ========================================================
-// =========== Simple 5x7 bitmap font for on-screen text ==========
-// ========================================================
-//
-// We will render characters as GL_POINTS in orthographic screen space.
-// Each character is 5x7 pixels. We keep the set small (digits, ., :, -, letters used).
-//
-// Font stored as 7 rows of 5 bits (LSB on right).
-//
-// ========================================================
-
-static const unsigned char font5x7[][7] = {
-    // ' ' (space) ASCII 32
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // '!' ASCII 33 (not used)
-    {0x04,0x04,0x04,0x04,0x00,0x00,0x04},
-    // '"' ASCII 34
-    {0x0A,0x0A,0x0A,0x00,0x00,0x00,0x00},
-    // '#' 35
-    {0x0A,0x0A,0x1F,0x0A,0x1F,0x0A,0x0A},
-    // '$' 36
-    {0x04,0x0F,0x14,0x0E,0x05,0x1E,0x04},
-    // '%' 37
-    {0x18,0x19,0x02,0x04,0x08,0x13,0x03},
-    // '&' 38
-    {0x0C,0x12,0x14,0x08,0x15,0x12,0x0D},
-    // '\'' 39
-    {0x06,0x06,0x02,0x00,0x00,0x00,0x00},
-    // '(' 40
-    {0x08,0x04,0x02,0x02,0x02,0x04,0x08},
-    // ')' 41
-    {0x02,0x04,0x08,0x08,0x08,0x04,0x02},
-    // '*' 42
-    {0x00,0x04,0x15,0x0E,0x15,0x04,0x00},
-    // '+' 43
-    {0x00,0x04,0x04,0x1F,0x04,0x04,0x00},
-    // ',' 44
-    {0x00,0x00,0x00,0x00,0x06,0x06,0x02},
-    // '-' 45
-    {0x00,0x00,0x00,0x1F,0x00,0x00,0x00},
-    // '.' 46
-    {0x00,0x00,0x00,0x00,0x06,0x06,0x00},
-    // '/' 47
-    {0x00,0x01,0x02,0x04,0x08,0x10,0x00},
-    // '0' 48
-    {0x0E,0x11,0x13,0x15,0x19,0x11,0x0E},
-    // '1' 49
-    {0x04,0x0C,0x04,0x04,0x04,0x04,0x0E},
-    // '2' 50
-    {0x0E,0x11,0x01,0x02,0x04,0x08,0x1F},
-    // '3' 51
-    {0x0E,0x11,0x01,0x06,0x01,0x11,0x0E},
-    // '4' 52
-    {0x02,0x06,0x0A,0x12,0x1F,0x02,0x02},
-    // '5' 53
-    {0x1F,0x10,0x1E,0x01,0x01,0x11,0x0E},
-    // '6' 54
-    {0x06,0x08,0x10,0x1E,0x11,0x11,0x0E},
-    // '7' 55
-    {0x1F,0x11,0x02,0x04,0x04,0x04,0x04},
-    // '8' 56
-    {0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E},
-    // '9' 57
-    {0x0E,0x11,0x11,0x0F,0x01,0x02,0x1C},
-    // ':' 58
-    {0x00,0x00,0x06,0x06,0x00,0x06,0x06},
-    // ';' 59
-    {0x00,0x00,0x06,0x06,0x00,0x06,0x02},
-    // '<' 60
-    {0x02,0x04,0x08,0x10,0x08,0x04,0x02},
-    // '=' 61
-    {0x00,0x00,0x1F,0x00,0x1F,0x00,0x00},
-    // '>' 62
-    {0x10,0x08,0x04,0x02,0x04,0x08,0x10},
-    // '?' 63
-    {0x0E,0x11,0x01,0x02,0x04,0x00,0x04},
-    // '@' 64
-    {0x0E,0x11,0x15,0x15,0x1D,0x10,0x0E},
-    // 'A' 65
-    {0x0E,0x11,0x11,0x1F,0x11,0x11,0x11},
-    // 'B' 66
-    {0x1E,0x11,0x11,0x1E,0x11,0x11,0x1E},
-    // 'C' 67
-    {0x0E,0x11,0x10,0x10,0x10,0x11,0x0E},
-    // 'D' 68
-    {0x1C,0x12,0x11,0x11,0x11,0x12,0x1C},
-    // 'E' 69
-    {0x1F,0x10,0x10,0x1E,0x10,0x10,0x1F},
-    // 'F' 70
-    {0x1F,0x10,0x10,0x1E,0x10,0x10,0x10},
-    // 'G' 71
-    {0x0E,0x11,0x10,0x17,0x11,0x11,0x0F},
-    // 'H' 72
-    {0x11,0x11,0x11,0x1F,0x11,0x11,0x11},
-    // 'I' 73
-    {0x0E,0x04,0x04,0x04,0x04,0x04,0x0E},
-    // 'J' 74
-    {0x07,0x02,0x02,0x02,0x02,0x12,0x0C},
-    // 'K' 75
-    {0x11,0x12,0x14,0x18,0x14,0x12,0x11},
-    // 'L' 76
-    {0x10,0x10,0x10,0x10,0x10,0x10,0x1F},
-    // 'M' 77
-    {0x11,0x1B,0x15,0x15,0x11,0x11,0x11},
-    // 'N' 78
-    {0x11,0x19,0x15,0x13,0x11,0x11,0x11},
-    // 'O' 79
-    {0x0E,0x11,0x11,0x11,0x11,0x11,0x0E},
-    // 'P' 80
-    {0x1E,0x11,0x11,0x1E,0x10,0x10,0x10},
-    // 'Q' 81
-    {0x0E,0x11,0x11,0x11,0x15,0x12,0x0D},
-    // 'R' 82
-    {0x1E,0x11,0x11,0x1E,0x14,0x12,0x11},
-    // 'S' 83
-    {0x0F,0x10,0x10,0x0E,0x01,0x01,0x1E},
-    // 'T' 84
-    {0x1F,0x04,0x04,0x04,0x04,0x04,0x04},
-    // 'U' 85
-    {0x11,0x11,0x11,0x11,0x11,0x11,0x0E},
-    // 'V' 86
-    {0x11,0x11,0x11,0x11,0x11,0x0A,0x04},
-    // 'W' 87
-    {0x11,0x11,0x11,0x15,0x15,0x1B,0x11},
-    // 'X' 88
-    {0x11,0x11,0x0A,0x04,0x0A,0x11,0x11},
-    // 'Y' 89
-    {0x11,0x11,0x11,0x0A,0x04,0x04,0x04},
-    // 'Z' 90
-    {0x1F,0x01,0x02,0x04,0x08,0x10,0x1F},
-    // '[' 91
-    {0x0E,0x08,0x08,0x08,0x08,0x08,0x0E},
-    // '\' 92
-    {0x00,0x10,0x08,0x04,0x02,0x01,0x00},
-    // ']' 93
-    {0x0E,0x02,0x02,0x02,0x02,0x02,0x0E},
-    // '^' 94
-    {0x04,0x0A,0x11,0x00,0x00,0x00,0x00},
-    // '_' 95
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x1F},
-    // '`' 96
-    {0x06,0x06,0x02,0x00,0x00,0x00,0x00},
-    // 'a' 97
-    {0x00,0x00,0x0E,0x01,0x0F,0x11,0x0F},
-    // 'b' 98
-    {0x10,0x10,0x1E,0x11,0x11,0x11,0x1E},
-    // 'c' 99
-    {0x00,0x00,0x0E,0x11,0x10,0x11,0x0E},
-    // 'd' 100
-    {0x01,0x01,0x0F,0x11,0x11,0x11,0x0F},
-    // 'e' 101
-    {0x00,0x00,0x0E,0x11,0x1F,0x10,0x0E},
-    // 'f' 102
-    {0x06,0x08,0x1E,0x08,0x08,0x08,0x08},
-    // 'g' 103
-    {0x00,0x00,0x0F,0x11,0x11,0x0F,0x01,}, // note: last row uses 8-bit but fits
-    // 'h' 104
-    {0x10,0x10,0x1E,0x11,0x11,0x11,0x11},
-    // 'i' 105
-    {0x04,0x00,0x0C,0x04,0x04,0x04,0x0E},
-    // 'j' 106
-    {0x02,0x00,0x06,0x02,0x02,0x12,0x0C},
-    // 'k' 107
-    {0x10,0x10,0x12,0x14,0x18,0x14,0x12},
-    // 'l' 108
-    {0x0C,0x04,0x04,0x04,0x04,0x04,0x0E},
-    // 'm' 109
-    {0x00,0x00,0x1A,0x15,0x15,0x11,0x11},
-    // 'n' 110
-    {0x00,0x00,0x1E,0x11,0x11,0x11,0x11},
-    // 'o' 111
-    {0x00,0x00,0x0E,0x11,0x11,0x11,0x0E},
-    // 'p' 112
-    {0x00,0x00,0x1E,0x11,0x11,0x1E,0x10},
-    // 'q' 113
-    {0x00,0x00,0x0F,0x11,0x11,0x0F,0x01},
-    // 'r' 114
-    {0x00,0x00,0x16,0x19,0x10,0x10,0x10},
-    // 's' 115
-    {0x00,0x00,0x0F,0x10,0x0E,0x01,0x1E},
-    // 't' 116
-    {0x08,0x08,0x1E,0x08,0x08,0x08,0x06},
-    // 'u' 117
-    {0x00,0x00,0x11,0x11,0x11,0x13,0x0D},
-    // 'v' 118
-    {0x00,0x00,0x11,0x11,0x11,0x0A,0x04},
-    // 'w' 119
-    {0x00,0x00,0x11,0x11,0x15,0x15,0x0A},
-    // 'x' 120
-    {0x00,0x00,0x11,0x0A,0x04,0x0A,0x11},
-    // 'y' 121
-    {0x00,0x00,0x11,0x11,0x0F,0x01,0x0E},
-    // 'z' 122
-    {0x00,0x00,0x1F,0x02,0x04,0x08,0x1F},
-    // '{' 123
-    {0x02,0x04,0x04,0x08,0x04,0x04,0x02},
-    // '|' 124
-    {0x04,0x04,0x04,0x00,0x04,0x04,0x04},
-    // '}' 125
-    {0x08,0x04,0x04,0x02,0x04,0x04,0x08},
-    // '~' 126
-    {0x08,0x15,0x02,0x00,0x00,0x00,0x00}
-};
-
-// Map ASCII char to font index; we'll provide a helper that maps common chars.
-int asciiToFontIndex(char c) {
-    // we stored space at index 0 and then ASCII sequence starting at 33 in the array; but to simplify
-    // we will map digits and A-Z, a-z and a few punctuation directly.
-    if (c == ' ') return 0;
-    if (c >= '0' && c <= '9') return (c - '0') + 48 - 32; // our table above aligns around ASCII, but simpler: handle digits manually below
-    // fallback: map limited set:
-    if (c >= 'A' && c <= 'Z') return (c - 'A') + (65 - 32);
-    if (c >= 'a' && c <= 'z') return (c - 'a') + (97 - 32);
-    // some punctuation
-    if (c == '.') return (46 - 32);
-    if (c == ':') return (58 - 32);
-    if (c == '-') return (45 - 32);
-    if (c == '%') return (37 - 32);
-    if (c == '/') return (47 - 32);
-    if (c == '+') return (43 - 32);
-    return 0; // space for unsupported
-}
-
-// Because we compiled a giant font table above (starting with space), we need a helper to fetch 5x7 rows.
-// But for simplicity here, we'll create a reduced function for digits, dot, colon, letters used in outputs.
-
-static const unsigned char digits_font[10][7] = {
-    {0x0E,0x11,0x13,0x15,0x19,0x11,0x0E}, // 0
-    {0x04,0x0C,0x04,0x04,0x04,0x04,0x0E}, // 1
-    {0x0E,0x11,0x01,0x02,0x04,0x08,0x1F}, // 2
-    {0x0E,0x11,0x01,0x06,0x01,0x11,0x0E}, // 3
-    {0x02,0x06,0x0A,0x12,0x1F,0x02,0x02}, // 4
-    {0x1F,0x10,0x1E,0x01,0x01,0x11,0x0E}, // 5
-    {0x06,0x08,0x10,0x1E,0x11,0x11,0x0E}, // 6
-    {0x1F,0x11,0x02,0x04,0x04,0x04,0x04}, // 7
-    {0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E}, // 8
-    {0x0E,0x11,0x11,0x0F,0x01,0x02,0x1C}  // 9
-};
-static const unsigned char char_dot[7] = {0x00,0x00,0x00,0x00,0x06,0x06,0x00};
-static const unsigned char char_colon[7] = {0x00,0x00,0x06,0x06,0x00,0x06,0x06};
-static const unsigned char char_minus[7] = {0x00,0x00,0x00,0x1F,0x00,0x00,0x00};
-static const unsigned char char_space[7] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00};
-static const unsigned char char_percent[7] = {0x18,0x19,0x02,0x04,0x08,0x13,0x03};
-
-// For text rendering we'll build a vertex buffer of points per frame.
-
-struct TextPoint {
-    float x, y; // screen space normalized (0..1), we'll convert to clip space in shader or feed ortho
-    float r, g, b, a;
-};
-
-// Simple text mesh builder: fills vector<TextPoint> with one point per lit pixel of the 5x7 font.
-// originX, originY in normalized screen coords (0..1) bottom-left origin, scale = relative size (0..1)
-void buildTextMesh(const string &text, float originX, float originY, float scale, vec3 color, vector<TextPoint> &outPoints) {
-    float cx = originX;
-    float cy = originY;
-    float charW = scale * 6.0f / WIN_W; // fudge factor to keep characters visible; later convert properly
-    float charH = scale * 8.0f / WIN_H;
-    // But simpler: we interpret scale as pixel size in screen-space fraction of height
-    // We'll act in normalized screen coords where height=1. Use char cell: w= (scale*0.05) etc.
-    float cw = scale * 0.04f; // width of one character cell
-    float ch = scale * 0.06f; // height of one character cell
-    // pixel spacing inside char: fraction of cell
-    float px = cw / 6.0f;
-    float py = ch / 8.0f;
-
-    for (size_t ci = 0; ci < text.size(); ++ci) {
-        char c = text[ci];
-        const unsigned char *glyph = nullptr;
-        unsigned char localGlyph[7];
-        bool useDigits = false;
-        if (c >= '0' && c <= '9') {
-            glyph = digits_font[c - '0'];
-            useDigits = true;
-        } else if (c == '.') {
-            glyph = char_dot;
-        } else if (c == ':') {
-            glyph = char_colon;
-        } else if (c == '-') {
-            glyph = char_minus;
-        } else if (c == ' ') {
-            glyph = char_space;
-        } else if (c == '%') {
-            glyph = char_percent;
-        } else {
-            // fallback: render characters individually if letter; simple A-Z mapping
-            if (c >= 'A' && c <= 'Z') {
-                int idx = c - 'A';
-                // map into our earlier font5x7 if available: try to access font5x7 at proper offset
-                // Because we didn't fully index font5x7 by ascii, fallback to space
-                glyph = char_space;
-            } else if (c >= 'a' && c <= 'z') {
-                glyph = char_space;
-            } else {
-                glyph = char_space;
-            }
-        }
-        // For glyph pointer safety, copy to local if needed
-        for (int row = 0; row < 7; ++row) {
-            unsigned char bits = glyph[row];
-            for (int col = 0; col < 5; ++col) {
-                bool bit = (bits >> (4 - col)) & 1;
-                if (bit) {
-                    // compute normalized position
-                    // draw top-left origin for text -> we will convert so originY is top
-                    float sx = cx + ci * (cw + cw*0.08f) + (col * px);
-                    float sy = cy - (row * py);
-                    TextPoint tp;
-                    tp.x = sx;
-                    tp.y = sy;
-                    tp.r = color.r; tp.g = color.g; tp.b = color.b; tp.a = 1.0f;
-                    outPoints.push_back(tp);
-                }
-            }
-        }
-    }
-}
-
 // Text shader: will take points in NDC directly. We'll provide an orthographic transform to map normalized screen coords to clip space
 const char* vs_text = R"GLSL(
 #version 330 core
@@ -850,6 +962,7 @@ void mouse_button_cb(GLFWwindow* w, int button, int action, int mods){
 }
 void cursor_pos_cb(GLFWwindow* w, double x, double y){
     if(camera.dragging){
+        frameLogInput(frameLog, pacingNow());
         float dx = float(x - camera.lastX);
         float dy = float(y - camera.lastY);
         camera.azimuth += dx * camera.orbitSpeed;
@@ -857,19 +970,86 @@ void cursor_pos_cb(GLFWwindow* w, double x, double y){
         camera.lastX = x; camera.lastY = y;
     }
 }
+void framebuffer_size_cb(GLFWwindow* w, int width, int height){
+    // render targets are reallocated lazily at the start of the next frame
+    WIN_W = width;
+    WIN_H = height;
+    framebufferResized = true;
+}
 void scroll_cb(GLFWwindow* w, double xoff, double yoff){
+    frameLogInput(frameLog, pacingNow());
     camera.radius -= float(yoff) * camera.zoomSpeed;
     camera.radius = clamp(camera.radius, 0.5f, 100.0f);
 }
 void key_cb(GLFWwindow* w, int key, int sc, int action, int mods){
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) glfwSetWindowShouldClose(w, true);
     if (key == GLFW_KEY_R && action == GLFW_PRESS) autoRotate = !autoRotate;
+    if (key == GLFW_KEY_N && action == GLFW_PRESS) {
+        nbodyEnabled = !nbodyEnabled;
+        cerr << "n-body cluster = " << (nbodyEnabled ? "on" : "off") << endl;
+    }
+    if (key == GLFW_KEY_T && action == GLFW_PRESS) {
+        geodesicsEnabled = !geodesicsEnabled;
+        cerr << "geodesic particles = " << (geodesicsEnabled ? "on" : "off") << endl;
+    }
+    if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+        usePhotonRingStrip = !usePhotonRingStrip;
+        cerr << "photon ring = " << (usePhotonRingStrip ? "critical curve" : "point annulus") << endl;
+    }
+    if (key == GLFW_KEY_K && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
+        BH_SPIN = glm::min(0.99f, BH_SPIN + 0.05f);
+        cerr << "BH_SPIN = " << BH_SPIN << endl;
+    }
+    if (key == GLFW_KEY_J && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
+        BH_SPIN = glm::max(0.0f, BH_SPIN - 0.05f);
+        cerr << "BH_SPIN = " << BH_SPIN << endl;
+    }
+    if (key == GLFW_KEY_LEFT_BRACKET && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
+        LENS_RENDER_SCALE = glm::max(LENS_RENDER_SCALE_MIN, LENS_RENDER_SCALE - 0.25f);
+        cerr << "LENS_RENDER_SCALE = " << LENS_RENDER_SCALE << endl;
+    }
+    if (key == GLFW_KEY_RIGHT_BRACKET && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
+        LENS_RENDER_SCALE = glm::min(LENS_RENDER_SCALE_MAX, LENS_RENDER_SCALE + 0.25f);
+        cerr << "LENS_RENDER_SCALE = " << LENS_RENDER_SCALE << endl;
+    }
+    if (key == GLFW_KEY_V && action == GLFW_PRESS) {
+        dynRes.enabled = !dynRes.enabled;
+        cerr << "dynamic resolution = " << (dynRes.enabled ? "on" : "off") << " (target " << dynRes.targetMs << " ms)" << endl;
+    }
+    if (key == GLFW_KEY_Y && action == GLFW_PRESS) {
+        SWAP_INTERVAL = (SWAP_INTERVAL + 1) % 3;
+        glfwSwapInterval(SWAP_INTERVAL);
+        cerr << "swap interval = " << SWAP_INTERVAL << endl;
+    }
+    if (key == GLFW_KEY_L && action == GLFW_PRESS) {
+        const int caps = int(sizeof(FRAME_RATE_CAPS) / sizeof(FRAME_RATE_CAPS[0]));
+        int next = 0;
+        for (int i = 0; i < caps; ++i) if (FRAME_RATE_CAPS[i] == FRAME_RATE_CAP) next = (i + 1) % caps;
+        FRAME_RATE_CAP = FRAME_RATE_CAPS[next];
+        framePacerSetRate(framePacer, FRAME_RATE_CAP);
+        cerr << "frame cap = " << FRAME_RATE_CAP << " fps" << endl;
+    }
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) {
+        useAdaptiveGrid = !useAdaptiveGrid;
+        cerr << "adaptive grid = " << (useAdaptiveGrid ? "on" : "off") << endl;
+    }
+    if (key == GLFW_KEY_H && action == GLFW_PRESS) {
+        FIELD_OVERLAY = (FIELD_OVERLAY + 1) % 3;
+        const char *names[] = { "off", "time dilation", "light deflection" };
+        cerr << "field overlay = " << names[FIELD_OVERLAY] << endl;
+    }
+    if (key == GLFW_KEY_F5 && action == GLFW_PRESS) {
+        if (SCENE_FILE.empty()) cerr << "no scene file to reload (--scene FILE)" << endl;
+        else if (applySceneSources()) cerr << "reloaded " << SCENE_FILE << endl;
+    }
     if (key == GLFW_KEY_UP && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
         BH_PIXEL_RES = glm::min(1024, BH_PIXEL_RES + 16);
+        sceneDirty |= DIRTY_BH_PIXELS;
         cerr << "BH_PIXEL_RES = " << BH_PIXEL_RES << endl;
     }
     if (key == GLFW_KEY_DOWN && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
         BH_PIXEL_RES = glm::max(16, BH_PIXEL_RES - 16);
+        sceneDirty |= DIRTY_BH_PIXELS;
         cerr << "BH_PIXEL_RES = " << BH_PIXEL_RES << endl;
     }
     if (key == GLFW_KEY_KP_ADD && (action==GLFW_PRESS||action==GLFW_REPEAT)) {
@@ -882,52 +1062,41 @@ void key_cb(GLFWwindow* w, int key, int sc, int action, int mods){
     }
 }
 
-// ========================================================
-// ================== Physics helpers (approx) ============
-// ========================================================
-//
-// We implement simple approximate formulas for display purposes only.
-// - gravitational radius (rg) is used as a scale; we tie it to BH_RADIUS in scene units.
-// - "time dilation factor" w.r.t distant observer: sqrt(1 - Rs / r)  (0 < factor <= 1).
-//   We'll clamp to a safe domain to avoid NaNs when r <= Rs.
-// - "spatial distortion" is an approximate normalized deflection value using 4*rg/r (derived from 4GM/(rc^2) scaling).
-//
-// These numbers are for visualization, not precise relativistic simulation.
-//
-// ========================================================
-
-float computeTimeDilationFactor(float rg_scene, float distance_from_center) {
-    // We treat rg_scene as the Schwarzschild radius scaled to scene units.
-    // Proper formula: sqrt(1 - Rs / r) ; Rs = 2GM/c^2. Here rg_scene acts as Rs for scaling.
-    float eps = 1e-4f;
-    float r = glm::max(distance_from_center, rg_scene + eps);
-    float inside = 1.0f - rg_scene / r;
-    if (inside <= 0.0f) return 0.0f;
-    return sqrt(inside);
-}
-
-float computeSpatialDistortionApprox(float rg_scene, float distance_from_center) {
-    // approximate deflection scale alpha ~ 4GM/(r c^2) -> ~ 2*Rs/r -> we use factor = clamp(4*rg/r, 0..5)
-    float r = glm::max(distance_from_center, 1e-4f);
-    float val = 4.0f * rg_scene / r;
-    // normalize to a visually useful range (0..1)
-    float normalized = val / (val + 1.0f); // maps 0..inf -> 0..1
-    return normalized;
-}
-
 // ========================================================
 // ====================== Main =============================
 // ========================================================
-int main() {
-    srand((unsigned)time(nullptr));
+int main(int argc, char** argv) {
+    // --scene FILE, --set KEY=VALUE (repeatable, applied after the file), --frames N,
+    // --dump-scene; --swap N, --fps F (0 = uncapped) and --latency-csv PATH are
+    // shorthands for the matching --set
+    bindSceneParams(sceneConfig);
+    bool dumpScene = false;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--scene" && hasValue) SCENE_FILE = argv[++i];
+        else if (arg == "--set" && hasValue) SCENE_OVERRIDES.push_back(argv[++i]);
+        else if (arg == "--frames" && hasValue) SCENE_OVERRIDES.push_back(string("RUN_FRAMES=") + argv[++i]);
+        else if (arg == "--swap" && hasValue) SCENE_OVERRIDES.push_back(string("SWAP_INTERVAL=") + argv[++i]);
+        else if (arg == "--fps" && hasValue) SCENE_OVERRIDES.push_back(string("FRAME_RATE_CAP=") + argv[++i]);
+        else if (arg == "--latency-csv" && hasValue) SCENE_OVERRIDES.push_back(string("LATENCY_CSV=") + argv[++i]);
+        else if (arg == "--dump-scene") dumpScene = true;
+        else cerr << "ignoring argument " << arg << endl;
+    }
+    if (!applySceneSources()) return 1;
+    if (dumpScene) { cout << sceneDump(sceneConfig); return 0; }
+    const bool batchRun = RUN_FRAMES > 0;
+
     if (!glfwInit()) { cerr<<"GLFW init failed\n"; return -1; }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    GLFWwindow* win = glfwCreateWindow(WIN_W, WIN_H, "Pixel Black Hole - GPU star ray warp + diagnostics", nullptr, nullptr);
+    GLFWwindow* win = glfwCreateWindow(WINDOW_W, WINDOW_H, "Pixel Black Hole - GPU star ray warp + diagnostics", nullptr, nullptr);
     if (!win) { cerr<<"Window creation failed\n"; glfwTerminate(); return -1; }
     glfwMakeContextCurrent(win);
+    glfwSwapInterval(SWAP_INTERVAL);
+    framePacerSetRate(framePacer, FRAME_RATE_CAP);
     glewExperimental = GL_TRUE;
     if (glewInit() != GLEW_OK) { cerr<<"GLEW init failed\n"; glfwTerminate(); return -1; }
 
@@ -936,6 +1105,8 @@ int main() {
     glfwSetCursorPosCallback(win, cursor_pos_cb);
     glfwSetScrollCallback(win, scroll_cb);
     glfwSetKeyCallback(win, key_cb);
+    glfwSetFramebufferSizeCallback(win, framebuffer_size_cb);
+    glfwGetFramebufferSize(win, &WIN_W, &WIN_H);
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_BLEND);
@@ -947,6 +1118,10 @@ int main() {
     GLuint fs_g = compileShader(GL_FRAGMENT_SHADER, fs_grid);
     GLuint progGrid = linkProgram(vs_g, fs_g);
 
+    GLuint vsF = compileShader(GL_VERTEX_SHADER, vs_field);
+    GLuint fsF = compileShader(GL_FRAGMENT_SHADER, fs_field);
+    GLuint progField = linkProgram(vsF, fsF);
+
     GLuint vsP = compileShader(GL_VERTEX_SHADER, vs_points);
     GLuint fsP = compileShader(GL_FRAGMENT_SHADER, fs_points);
     GLuint progPoints = linkProgram(vsP, fsP);
@@ -958,6 +1133,12 @@ int main() {
     GLuint vsQ = compileShader(GL_VERTEX_SHADER, vs_quad);
     GLuint fsWarp = compileShader(GL_FRAGMENT_SHADER, fs_warp_stars);
     GLuint progWarp = linkProgram(vsQ, fsWarp);
+    GLuint fsBlit = compileShader(GL_FRAGMENT_SHADER, fs_blit);
+    GLuint progBlit = linkProgram(vsQ, fsBlit);
+
+    GLuint vsR = compileShader(GL_VERTEX_SHADER, vs_ring);
+    GLuint fsR = compileShader(GL_FRAGMENT_SHADER, fs_points);
+    GLuint progRing = linkProgram(vsR, fsR);
 
     // compile text shader
     GLuint vsT = compileShader(GL_VERTEX_SHADER, vs_text);
@@ -977,7 +1158,14 @@ int main() {
 
     // generate scene geometry
     GridMesh grid; generateGrid(grid, 28, 0.12f, 3.2f);
-
+    AdaptiveGrid adaptiveGrid;
+    GridMesh adaptiveGridMesh;
+    updateAdaptiveGrid(adaptiveGrid, camera.radius);
+    uploadGridMesh(adaptiveGridMesh, adaptiveGrid.geometry);
+    FieldOverlay fieldOverlay;
+    setupFieldOverlay(fieldOverlay);
+
+    // ring / disk / BH pixels are written straight into their VBOs
     MeshBuffer bhPixels, diskPixels, ringPixels;
     generateBlackHolePixels(bhPixels, BH_PIXEL_RES, BH_RADIUS);
 
@@ -986,46 +1174,63 @@ int main() {
                             DISK_RADIAL_STEPS, DISK_ANGULAR_STEPS, blackPos.y);
 
     generatePhotonRingBillboard(ringPixels, PH_RING_IN, PH_RING_OUT, PH_RING_SAMPLES);
+    PhotonRingCache ringCache;
+    PhotonRingStrip ringStrip;
+    auto makeSubrings = [] {
+        vector<PhotonSubring> rings = photonSubrings(PH_RING_ORDERS);
+        for (auto &r : rings) r.brightness = PH_RING_BRIGHTNESS;
+        return rings;
+    };
+    vector<PhotonSubring> subrings = makeSubrings();
 
     setupStars();
     uploadStars();
 
-    // upload pixel buffers
-    uploadMesh(bhPixels);
-    uploadMesh(diskPixels);
-    uploadMesh(ringPixels);
-
-    // prepare star FBO: render only stars to texture, then apply warp postprocess
-    GLuint starsFBO=0, starsTex=0, starsRBO=0;
-    glGenFramebuffers(1, &starsFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, starsFBO);
-
-    glGenTextures(1, &starsTex);
-    glBindTexture(GL_TEXTURE_2D, starsTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIN_W, WIN_H, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // smoothing is ok for stars layer
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, starsTex, 0);
-
-    // depth renderbuffer (we don't need depth for stars layer but keep it to ensure correct behavior)
-    glGenRenderbuffers(1, &starsRBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, starsRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, WIN_W, WIN_H);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, starsRBO);
-
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        cerr << "Star FBO incomplete\n";
-    }
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-    // projection
-    mat4 proj = perspective(radians(60.0f), float(WIN_W)/float(WIN_H), 0.1f, 300.0f);
+    NBodySystem cluster;
+    cluster.params.softening = 0.02f;
+    auto initCluster = [&] { nbodyInitOrbitingDisk(cluster, NBODY_COUNT, 1.0f, 2e-5f, 1.3f, 3.2f, 0.06f, 7u); };
+    initCluster();
+    vector<Star> clusterStars;
+    GLuint clusterVAO = 0, clusterVBO = 0;
+    GeodesicBatch geoParticles;
+    setupGeodesicParticles(geoParticles, GEO_PARTICLES);
+    MeshBuffer geoPixels;
+    GeodesicDrift geoDrift;
+    double geoStepRate = 0.0;   // particle-steps per second of wall time
+
+    double lastFrameTime = glfwGetTime();
+
+    // Offscreen targets, sized in the frame loop (framebuffer size x LENS_RENDER_SCALE):
+    //  starsTarget: stars only, input of the warp postprocess
+    //  lensTarget: warped stars when the lensing pass does not run at 1x
+    //  sceneTarget: grid/disk/BH + lensing at the dynamic resolution scale, upscaled before the text
+    RenderTarget starsTarget, lensTarget, sceneTarget;
+
+    // GPU time of the scene + lensing passes; a small ring so results are read a few
+    // frames late instead of stalling on the current one
+    const int GPU_TIMER_QUERIES = 4;
+    GLuint gpuTimers[GPU_TIMER_QUERIES];
+    glGenQueries(GPU_TIMER_QUERIES, gpuTimers);
+    int gpuTimerFrame = 0;
+    float gpuFrameMs = 0.0f;
+    double gpuMsSum = 0.0;      // for the --frames RESULT line
+    int gpuMsSamples = 0;
+    int framesRendered = 0;
+
+    // everything above was built from the loaded scene
+    sceneDirty = 0;
 
     // uniform locations
     GLint loc_uMVP_points = glGetUniformLocation(progPoints, "uMVP");
     GLint loc_pointSize = glGetUniformLocation(progPoints, "uPointSize");
     GLint loc_uMVP_star = glGetUniformLocation(progStar, "uMVP");
     GLint loc_uMVP_grid = glGetUniformLocation(progGrid, "uMVP");
+    GLint loc_field_uMVP = glGetUniformLocation(progField, "uMVP");
+    GLint loc_field_invert = glGetUniformLocation(progField, "uInvert");
+    GLint loc_field_alpha = glGetUniformLocation(progField, "uAlpha");
+    GLint loc_ring_uMVP = glGetUniformLocation(progRing, "uMVP");
+    GLint loc_ring_unitsPerM = glGetUniformLocation(progRing, "uUnitsPerM");
+    GLint loc_ring_minHalfWidth = glGetUniformLocation(progRing, "uMinHalfWidth");
 
     GLint loc_warp_bhUV = glGetUniformLocation(progWarp, "uBH_UV");
     GLint loc_warp_strength = glGetUniformLocation(progWarp, "uStrength");
@@ -1033,9 +1238,11 @@ int main() {
     GLint loc_warp_radius = glGetUniformLocation(progWarp, "uEffectRadius");
     GLint loc_warp_ringsharp = glGetUniformLocation(progWarp, "uRingSharpness");
     GLint loc_warp_starsTex = glGetUniformLocation(progWarp, "uStarsTex");
+    GLint loc_blit_tex = glGetUniformLocation(progBlit, "uTex");
 
     // star program MVP location
     GLint loc_star_uMVP = glGetUniformLocation(progStar, "uMVP");
+    GLint loc_star_sizeScale = glGetUniformLocation(progStar, "uSizeScale");
 
     // text uniform
     GLint loc_text_pointSize = glGetUniformLocation(progText, "uPointSize");
@@ -1047,43 +1254,191 @@ int main() {
 
     // Main loop
     while (!glfwWindowShouldClose(win)) {
+        // wait for the frame slot, then sample input as late as possible
+        framePacerWait(framePacer);
+        glfwPollEvents();
+        frameLogBegin(frameLog);
+
+        // rebuild only what changed since the last frame (F5 reload, UP/DOWN)
+        if (sceneDirty) {
+            const unsigned dirty = sceneDirty;
+            sceneDirty = 0;
+            if (dirty & DIRTY_BH_PIXELS) generateBlackHolePixels(bhPixels, BH_PIXEL_RES, BH_RADIUS);
+            if (dirty & DIRTY_DISK)
+                generateDiskPixelsWorld(diskPixels, DISK_INNER, DISK_OUTER, DISK_THICKNESS,
+                                        DISK_RADIAL_STEPS, DISK_ANGULAR_STEPS, blackPos.y);
+            if (dirty & DIRTY_RING_CLOUD) generatePhotonRingBillboard(ringPixels, PH_RING_IN, PH_RING_OUT, PH_RING_SAMPLES);
+            if (dirty & DIRTY_RING_STRIP) {
+                subrings = makeSubrings();
+                ringStrip.key = 0xffffffffu;   // re-upload with the new instances
+            }
+            if (dirty & DIRTY_NBODY) initCluster();
+            if (dirty & DIRTY_GEODESICS) setupGeodesicParticles(geoParticles, GEO_PARTICLES);
+            if (dirty & DIRTY_WINDOW) glfwSetWindowSize(win, WINDOW_W, WINDOW_H);
+            if (dirty & DIRTY_PACING) {
+                glfwSwapInterval(SWAP_INTERVAL);
+                framePacerSetRate(framePacer, FRAME_RATE_CAP);
+            }
+        }
+
+        // minimized: nothing to draw into
+        if (WIN_W <= 0 || WIN_H <= 0) { glfwWaitEvents(); continue; }
+        if (framebufferResized) {
+            cerr << "framebuffer " << WIN_W << "x" << WIN_H << endl;
+            framebufferResized = false;
+        }
+        // collect the oldest timer result and let the controller pick this frame's scale
+        if (gpuTimerFrame >= GPU_TIMER_QUERIES) {
+            GLuint oldest = gpuTimers[gpuTimerFrame % GPU_TIMER_QUERIES];
+            GLint available = 0;
+            glGetQueryObjectiv(oldest, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(oldest, GL_QUERY_RESULT, &ns);
+                gpuFrameMs = float(ns * 1e-6);
+                gpuMsSum += gpuFrameMs;
+                ++gpuMsSamples;
+                updateDynamicResolution(dynRes, gpuFrameMs);
+            }
+        }
+
+        // the scene renders into sceneTarget only while it is scaled down
+        const float sceneScale = dynRes.enabled ? dynRes.scale : 1.0f;
+        const int sceneW = glm::max(1, int(WIN_W * sceneScale + 0.5f));
+        const int sceneH = glm::max(1, int(WIN_H * sceneScale + 0.5f));
+        const bool sceneAtNative = (sceneW == WIN_W && sceneH == WIN_H);
+        if (!sceneAtNative) ensureRenderTarget(sceneTarget, sceneW, sceneH, true);
+        const GLuint sceneFBO = sceneAtNative ? 0 : sceneTarget.fbo;
+        const float pxScale = float(sceneW) / float(WIN_W);   // point sprite sizes follow the scene scale
+
+        const int lensW = glm::max(1, int(sceneW * LENS_RENDER_SCALE + 0.5f));
+        const int lensH = glm::max(1, int(sceneH * LENS_RENDER_SCALE + 0.5f));
+        const bool lensAtNative = (lensW == sceneW && lensH == sceneH);
+        ensureRenderTarget(starsTarget, lensW, lensH, true);
+        if (!lensAtNative) ensureRenderTarget(lensTarget, lensW, lensH, false);
+        mat4 proj = perspective(radians(60.0f), float(WIN_W)/float(WIN_H), 0.1f, 300.0f);
+
         // basic updates
         if (!camera.dragging && autoRotate) camera.azimuth += 0.0009f;
+        double frameTime = glfwGetTime();
+        float frameDt = float(glm::min(frameTime - lastFrameTime, 0.1));
+        lastFrameTime = frameTime;
+
+        if (nbodyEnabled) {
+            nbodyStep(cluster, frameDt * NBODY_TIME_SCALE);
+            nbodyToStars(cluster, blackPos, clusterStars);
+            uploadStarBuffer(clusterVAO, clusterVBO, clusterStars, GL_STREAM_DRAW);
+        }
+
+        const float sceneM = BH_RADIUS * 0.9f * 0.5f; // Rs_scene / 2
+        if (geodesicsEnabled) {
+            int steps = glm::max(1, int(ceil(frameDt * GEO_TIME_SCALE / GEO_DTAU)));
+            double t0 = glfwGetTime();
+            geodesicStep(geoParticles, GEO_DTAU, steps);
+            double spent = glfwGetTime() - t0;
+            if (spent > 0.0) geoStepRate = double(geoParticles.count) * steps / spent;
+            geoDrift = geodesicMeasureDrift(geoParticles);
+            geodesicsToPixels(geoParticles, blackPos, sceneM, geoPixels.pixels);
+            geoPixels.count = (int)geoPixels.pixels.size();
+            uploadMesh(geoPixels);
+        }
 
         // view/proj
         vec3 camPos = camera.position();
         mat4 view = lookAt(camPos, camera.target, vec3(0,1,0));
         mat4 VP = proj * view;
 
+        // critical curve for the current spin and viewing inclination (spin axis = world y)
+        if (usePhotonRingStrip) {
+            vec3 toCam = normalize(camPos - blackPos);
+            uint32_t ringKey = 0;
+            const PhotonRingCurve &curve = photonRingCached(ringCache, BH_SPIN, acos(clamp(toCam.y, -1.0f, 1.0f)), &ringKey);
+            if (ringKey != ringStrip.key) {
+                uploadPhotonRingStrip(ringStrip, curve, subrings);
+                ringStrip.key = ringKey;
+            }
+        }
+        auto drawPhotonRing = [&](const mat4 &mvp, float pointSize) {
+            if (usePhotonRingStrip) {
+                glUseProgram(progRing);
+                if (loc_ring_uMVP >= 0) glUniformMatrix4fv(loc_ring_uMVP, 1, GL_FALSE, value_ptr(mvp));
+                // Schwarzschild radius 3*sqrt(3) M sits in the middle of the annulus
+                const float ringUnitsPerM = 0.5f * (PH_RING_IN + PH_RING_OUT) / (3.0f * sqrt(3.0f));
+                if (loc_ring_unitsPerM >= 0) glUniform1f(loc_ring_unitsPerM, ringUnitsPerM);
+                if (loc_ring_minHalfWidth >= 0) glUniform1f(loc_ring_minHalfWidth, PH_RING_MIN_HALF_WIDTH);
+                glBindVertexArray(ringStrip.vao);
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, ringStrip.vertexCount, ringStrip.instanceCount);
+                glBindVertexArray(0);
+                glUseProgram(progPoints);
+                return;
+            }
+            if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(mvp));
+            if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pointSize * pxScale);
+            glBindVertexArray(ringPixels.vao);
+            glDrawArrays(GL_POINTS, 0, ringPixels.count);
+            glBindVertexArray(0);
+        };
+
+        // CPU-side mesh updates: the adaptive grid follows camera.radius
+        if (useAdaptiveGrid && updateAdaptiveGrid(adaptiveGrid, camera.radius))
+            uploadGridMesh(adaptiveGridMesh, adaptiveGrid.geometry);
+        if (FIELD_OVERLAY > 0)
+            updateFieldOverlay(fieldOverlay, FIELD_OVERLAY, BH_RADIUS * 0.9f, blackPos);   // Rs_scene, as in the HUD
+
+        // GPU time from the first draw pass on: the simulation steps and uploads above
+        // would otherwise count as GPU time (the GPU idles while the CPU runs them), and
+        // dynamic resolution would scale down for work it can't reduce
+        glBeginQuery(GL_TIME_ELAPSED, gpuTimers[gpuTimerFrame % GPU_TIMER_QUERIES]);
+
         // ---------------------------
         // 1) Render stars into FBO (only stars)
         // ---------------------------
-        glBindFramebuffer(GL_FRAMEBUFFER, starsFBO);
-        glViewport(0,0,WIN_W,WIN_H);
+        glBindFramebuffer(GL_FRAMEBUFFER, starsTarget.fbo);
+        glViewport(0,0,starsTarget.w,starsTarget.h);
         glClearColor(0.0f,0.0f,0.0f,0.0f); // transparent background so we can composite
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // draw stars as point sprites
         glUseProgram(progStar);
         if (loc_star_uMVP >= 0) glUniformMatrix4fv(loc_star_uMVP, 1, GL_FALSE, value_ptr(VP));
+        if (loc_star_sizeScale >= 0) glUniform1f(loc_star_sizeScale, float(starsTarget.w) / float(WIN_W));
         glBindVertexArray(starsVAO);
         glDrawArrays(GL_POINTS, 0, (GLsizei)stars.size());
+        if (nbodyEnabled && clusterVAO) {
+            glBindVertexArray(clusterVAO);
+            glDrawArrays(GL_POINTS, 0, (GLsizei)clusterStars.size());
+        }
         glBindVertexArray(0);
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0); // back to default
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO); // back to default (or the scaled scene)
 
         // ---------------------------
         // 2) Clear default framebuffer and draw grid/disk/BH (background + foreground)
         // ---------------------------
-        glViewport(0,0,WIN_W,WIN_H);
+        glViewport(0,0,sceneW,sceneH);
         glClearColor(0.02f, 0.01f, 0.01f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+        // metric field colormap (H) on the grid surface, pushed back so the lines stay on top
+        if (FIELD_OVERLAY > 0) {
+            glUseProgram(progField);
+            if (loc_field_uMVP >= 0) glUniformMatrix4fv(loc_field_uMVP, 1, GL_FALSE, value_ptr(VP));
+            glUniform1f(loc_field_invert, FIELD_OVERLAY == 1 ? 1.0f : 0.0f);
+            glUniform1f(loc_field_alpha, FIELD_OVERLAY_ALPHA);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(1.0f, 1.0f);
+            glBindVertexArray(fieldOverlay.vao);
+            glDrawElements(GL_TRIANGLES, fieldOverlay.indexCount, GL_UNSIGNED_INT, 0);
+            glBindVertexArray(0);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+        }
+
         // draw grid (lines)
+        const GridMesh &activeGrid = useAdaptiveGrid ? adaptiveGridMesh : grid;
         glUseProgram(progGrid);
         if (loc_uMVP_grid >= 0) glUniformMatrix4fv(loc_uMVP_grid, 1, GL_FALSE, value_ptr(VP));
-        glBindVertexArray(grid.vao);
-        glDrawElements(GL_LINES, grid.indexCount, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(activeGrid.vao);
+        glDrawElements(GL_LINES, activeGrid.indexCount, GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
 
         // draw disk (world horizontal)
@@ -1091,25 +1446,30 @@ int main() {
         mat4 diskModel = translate(mat4(1.0f), vec3(0.0f, 0.0f, 0.0f)); // disk pixels already at blackPos.y
         mat4 diskMVP = VP * diskModel;
         if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(diskMVP));
-        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * 1.25f);
+        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * 1.25f * pxScale);
         glBindVertexArray(diskPixels.vao);
         glDrawArrays(GL_POINTS, 0, diskPixels.count);
         glBindVertexArray(0);
 
+        // geodesic test particles (world space)
+        if (geodesicsEnabled && geoPixels.vao) {
+            if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(VP));
+            if (loc_pointSize >= 0) glUniform1f(loc_pointSize, 3.0f * pxScale);
+            glBindVertexArray(geoPixels.vao);
+            glDrawArrays(GL_POINTS, 0, geoPixels.count);
+            glBindVertexArray(0);
+        }
+
         // draw photon ring billboard (slightly outside) - will be composited on top of the (warped) star layer later visually
         mat4 ringModel = makeBillboardModel(vec3(blackPos.x, blackPos.y + 0.0f, blackPos.z), camPos, 1.0f);
         mat4 ringMVP = VP * ringModel;
-        if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(ringMVP));
-        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * 0.95f);
-        glBindVertexArray(ringPixels.vao);
-        glDrawArrays(GL_POINTS, 0, ringPixels.count);
-        glBindVertexArray(0);
+        drawPhotonRing(ringMVP, pixelPointSize * 0.95f);
 
         // draw BH billboard center on top so it occludes disk center
         mat4 bhModel = makeBillboardModel(blackPos, camPos, 0.7f);
         mat4 bhMVP = VP * bhModel;
         if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(bhMVP));
-        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize);
+        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * pxScale);
         glBindVertexArray(bhPixels.vao);
         glDrawArrays(GL_POINTS, 0, bhPixels.count);
         glBindVertexArray(0);
@@ -1124,7 +1484,7 @@ int main() {
 
         // bind star texture to unit 0
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, starsTex);
+        glBindTexture(GL_TEXTURE_2D, starsTarget.tex);
 
         // prepare shader
         glUseProgram(progWarp);
@@ -1141,16 +1501,35 @@ int main() {
 
         // draw full-screen quad
         glBindVertexArray(quadVAO);
-        // enable blending so warped stars composite nicely
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        if (lensAtNative) {
+            // enable blending so warped stars composite nicely
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        } else {
+            // warp at the lensing resolution, then composite the layer at full resolution
+            glBindFramebuffer(GL_FRAMEBUFFER, lensTarget.fbo);
+            glViewport(0,0,lensTarget.w,lensTarget.h);
+            glClearColor(0.0f,0.0f,0.0f,0.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDisable(GL_BLEND);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+            glViewport(0,0,sceneW,sceneH);
+
+            glUseProgram(progBlit);
+            if (loc_blit_tex >= 0) glUniform1i(loc_blit_tex, 0);
+            glBindTexture(GL_TEXTURE_2D, lensTarget.tex);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
         glBindVertexArray(0);
 
         // re-draw BH center on top to ensure it fully occludes star rays behind it
         glUseProgram(progPoints);
         if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(bhMVP));
-        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize);
+        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * pxScale);
         glBindVertexArray(bhPixels.vao);
         glDrawArrays(GL_POINTS, 0, bhPixels.count);
         glBindVertexArray(0);
@@ -1158,11 +1537,18 @@ int main() {
         // Optionally: draw ring again with additive blending for glow (small)
         glEnable(GL_BLEND);
         glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        if (loc_uMVP_points >= 0) glUniformMatrix4fv(loc_uMVP_points, 1, GL_FALSE, value_ptr(ringMVP));
-        if (loc_pointSize >= 0) glUniform1f(loc_pointSize, pixelPointSize * 1.05f);
-        glBindVertexArray(ringPixels.vao);
-        glDrawArrays(GL_POINTS, 0, ringPixels.count);
-        glBindVertexArray(0);
+        drawPhotonRing(ringMVP, pixelPointSize * 1.05f);
+
+        // upscale the scaled scene to the framebuffer; text below stays at native resolution
+        if (!sceneAtNative) {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneTarget.fbo);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+            glBlitFramebuffer(0, 0, sceneW, sceneH, 0, 0, WIN_W, WIN_H, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glViewport(0,0,WIN_W,WIN_H);
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        ++gpuTimerFrame;
 
         // ============================
         // Diagnostics: compute dilation & distortion and render on-screen
@@ -1177,14 +1563,26 @@ int main() {
         float spatialDist = computeSpatialDistortionApprox(Rs_scene, camDistance);
 
         // Build strings for display
-        std::ostringstream ss1, ss2, ss3;
+        std::ostringstream ss1, ss2, ss3, ss4, ss5, ss6;
         ss1<<fixed<<setprecision(4)<<"CamDist: "<<camDistance;
         ss2<<fixed<<setprecision(5)<<"TimeDilFactor: "<<timeDilationFactor;
         ss3<<fixed<<setprecision(5)<<"DilInverse: "<<timeDilationInverse<<"  SpatialDist: "<<spatialDist;
+        ss4<<"GridVerts: "<<activeGrid.vertCount<<" / "<<grid.vertCount;
+        if (FIELD_OVERLAY > 0) ss4<<"  Field: "<<(FIELD_OVERLAY == 1 ? "dilation" : "deflection");
 
         string line1 = ss1.str();
         string line2 = ss2.str();
         string line3 = ss3.str();
+        string line4 = ss4.str();
+        if (geodesicsEnabled) {
+            ss5<<scientific<<setprecision(2)<<"GeoDrift E: "<<geoDrift.maxRelE<<" L: "<<geoDrift.maxRelL
+               <<"  Alive: "<<geoDrift.alive<<"  MSteps: "<<fixed<<setprecision(1)<<geoStepRate*1e-6;
+        }
+        string line5 = ss5.str();
+        if (dynRes.enabled) {
+            ss6<<fixed<<setprecision(3)<<"ResScale: "<<dynRes.scale<<"  GPU: "<<setprecision(2)<<gpuFrameMs<<" / "<<dynRes.targetMs;
+        }
+        string line6 = ss6.str();
 
         // Build text mesh (top-left). Our build function expects origin at top-left; we will place top-left at (0.02, 0.95)
         vector<TextPoint> textPoints;
@@ -1193,9 +1591,12 @@ int main() {
         float textScale = 0.9f; // knob: change to scale text
 
         // We'll render each line separately with slight vertical offsets
-        buildTextMesh(line1, originX, originY, 0.9f, vec3(1.0f, 0.8f, 0.6f), textPoints);
-        buildTextMesh(line2, originX, originY - 0.09f, 0.9f, vec3(1.0f, 0.8f, 0.6f), textPoints);
-        buildTextMesh(line3, originX, originY - 0.18f, 0.9f, vec3(1.0f, 0.8f, 0.6f), textPoints);
+        buildTextMesh(line1, originX, originY, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
+        buildTextMesh(line2, originX, originY - 0.09f, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
+        buildTextMesh(line3, originX, originY - 0.18f, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
+        buildTextMesh(line4, originX, originY - 0.27f, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
+        if (!line5.empty()) buildTextMesh(line5, originX, originY - 0.36f, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
+        if (!line6.empty()) buildTextMesh(line6, originX, originY - 0.45f, 0.9f, 1.0f, 0.8f, 0.6f, textPoints);
 
         // Upload text points to VBO
         glBindVertexArray(textVAO);
@@ -1242,13 +1643,38 @@ int main() {
 
         // swap
         glfwSwapBuffers(win);
-        glfwPollEvents();
+        frameLogSwapped(frameLog, pacingNow());
+        if (batchRun && ++framesRendered >= RUN_FRAMES) glfwSetWindowShouldClose(win, true);
+    }
+
+    FrameLogSummary pacing = frameLogSummary(frameLog);
+    cerr << fixed << setprecision(2)
+         << "frames: " << pacing.frames << "  interval mean " << pacing.intervalMean << " ms, p99 " << pacing.intervalP99 << " ms\n"
+         << "input-to-swap latency (" << pacing.latencySamples << " samples): p50 " << pacing.latencyP50
+         << " ms, p90 " << pacing.latencyP90 << " ms, p99 " << pacing.latencyP99 << " ms, max " << pacing.latencyMax << " ms" << endl;
+    if (batchRun) {
+        // one line per run, easy to collect from a sweep script
+        cout << fixed << setprecision(3)
+             << "RESULT scene=" << (SCENE_FILE.empty() ? "-" : SCENE_FILE)
+             << " frames=" << framesRendered
+             << " fb=" << WIN_W << "x" << WIN_H
+             << " interval_mean_ms=" << pacing.intervalMean
+             << " interval_p99_ms=" << pacing.intervalP99
+             << " gpu_mean_ms=" << (gpuMsSamples ? gpuMsSum / gpuMsSamples : 0.0) << endl;
+    }
+    if (!LATENCY_CSV.empty()) {
+        if (frameLogWriteCsv(frameLog, LATENCY_CSV)) cerr << "frame log written to " << LATENCY_CSV << endl;
+        else cerr << "could not write " << LATENCY_CSV << endl;
     }
 
     // cleanup
     if (grid.vao) glDeleteVertexArrays(1, &grid.vao);
     if (grid.vbo) glDeleteBuffers(1, &grid.vbo);
     if (grid.ebo) glDeleteBuffers(1, &grid.ebo);
+    if (adaptiveGridMesh.vao) glDeleteVertexArrays(1, &adaptiveGridMesh.vao);
+    if (adaptiveGridMesh.vbo) glDeleteBuffers(1, &adaptiveGridMesh.vbo);
+    if (adaptiveGridMesh.ebo) glDeleteBuffers(1, &adaptiveGridMesh.ebo);
+    destroyFieldOverlay(fieldOverlay);
 
     if (bhPixels.vao) glDeleteVertexArrays(1, &bhPixels.vao);
     if (bhPixels.vbo) glDeleteBuffers(1, &bhPixels.vbo);
@@ -1256,9 +1682,16 @@ int main() {
     if (diskPixels.vbo) glDeleteBuffers(1, &diskPixels.vbo);
     if (ringPixels.vao) glDeleteVertexArrays(1, &ringPixels.vao);
     if (ringPixels.vbo) glDeleteBuffers(1, &ringPixels.vbo);
+    if (ringStrip.vao) glDeleteVertexArrays(1, &ringStrip.vao);
+    if (ringStrip.vbo) glDeleteBuffers(1, &ringStrip.vbo);
+    if (ringStrip.instanceVbo) glDeleteBuffers(1, &ringStrip.instanceVbo);
+    if (geoPixels.vao) glDeleteVertexArrays(1, &geoPixels.vao);
+    if (geoPixels.vbo) glDeleteBuffers(1, &geoPixels.vbo);
 
     if (starsVAO) glDeleteVertexArrays(1, &starsVAO);
     if (starsVBO) glDeleteBuffers(1, &starsVBO);
+    if (clusterVAO) glDeleteVertexArrays(1, &clusterVAO);
+    if (clusterVBO) glDeleteBuffers(1, &clusterVBO);
 
     if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
     if (quadVBO) glDeleteBuffers(1, &quadVBO);
@@ -1266,14 +1699,18 @@ int main() {
     if (textVAO) glDeleteVertexArrays(1, &textVAO);
     if (textVBO) glDeleteBuffers(1, &textVBO);
 
-    if (starsFBO) glDeleteFramebuffers(1, &starsFBO);
-    if (starsTex) glDeleteTextures(1, &starsTex);
-    if (starsRBO) glDeleteRenderbuffers(1, &starsRBO);
+    destroyRenderTarget(starsTarget);
+    destroyRenderTarget(lensTarget);
+    destroyRenderTarget(sceneTarget);
+    glDeleteQueries(GPU_TIMER_QUERIES, gpuTimers);
 
     glDeleteProgram(progGrid);
+    glDeleteProgram(progField);
     glDeleteProgram(progPoints);
+    glDeleteProgram(progRing);
     glDeleteProgram(progStar);
     glDeleteProgram(progWarp);
+    glDeleteProgram(progBlit);
     glDeleteProgram(progText);
 
     glfwDestroyWindow(win);
@@ -0,0 +1,107 @@
+// frame_pacing.cpp
+// Frame limiter and latency log, see frame_pacing.hpp.
+
+#include "frame_pacing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+using namespace std;
+
+double pacingNow() {
+    using namespace std::chrono;
+    static const steady_clock::time_point start = steady_clock::now();
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+void framePacerSetRate(FramePacer &p, double fps) {
+    p.fps = max(fps, 0.0);
+    p.nextDeadline = 0.0;
+}
+
+void framePacerWait(FramePacer &p) {
+    if (p.fps <= 0.0) return;
+#ifdef _WIN32
+    // 1 ms scheduler tick instead of the default 15.6 ms
+    static const bool finePeriod = (timeBeginPeriod(1) == TIMERR_NOERROR);
+    (void)finePeriod;
+#endif
+    const double period = 1.0 / p.fps;
+    double now = pacingNow();
+    if (p.nextDeadline <= 0.0 || now - p.nextDeadline > period) p.nextDeadline = now;
+
+    double sleepFor = p.nextDeadline - now - p.spinMargin;
+    if (sleepFor > 0.0) {
+        double before = pacingNow();
+        this_thread::sleep_for(chrono::duration<double>(sleepFor));
+        double over = (pacingNow() - before) - sleepFor;
+        p.oversleep = p.oversleep * 0.9 + max(over, 0.0) * 0.1;
+        p.spinMargin = min(max(p.oversleep * 2.0 + 0.0002, 0.0005), 0.004);
+    }
+    while (pacingNow() < p.nextDeadline) this_thread::yield();
+    p.nextDeadline += period;
+}
+
+void frameLogInput(FrameLog &log, double t) {
+    if (log.pendingInput <= 0.0) log.pendingInput = t;
+}
+
+void frameLogBegin(FrameLog &log) {
+    if (log.inFlightInput <= 0.0) log.inFlightInput = log.pendingInput;
+    log.pendingInput = 0.0;
+}
+
+void frameLogSwapped(FrameLog &log, double t) {
+    if (log.lastSwap > 0.0 && log.intervalMs.size() < log.maxFrames) {
+        log.intervalMs.push_back(float((t - log.lastSwap) * 1e3));
+        log.latencyMs.push_back(log.inFlightInput > 0.0 ? float((t - log.inFlightInput) * 1e3) : -1.0f);
+    }
+    log.lastSwap = t;
+    log.inFlightInput = 0.0;
+}
+
+static double percentile(vector<float> &sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    size_t i = min(sorted.size() - 1, size_t(q * (sorted.size() - 1) + 0.5));
+    return sorted[i];
+}
+
+FrameLogSummary frameLogSummary(const FrameLog &log) {
+    FrameLogSummary s;
+    s.frames = log.intervalMs.size();
+    if (s.frames == 0) return s;
+    vector<float> intervals = log.intervalMs;
+    double sum = 0.0;
+    for (float v : intervals) sum += v;
+    s.intervalMean = sum / intervals.size();
+    sort(intervals.begin(), intervals.end());
+    s.intervalP99 = percentile(intervals, 0.99);
+
+    vector<float> lat;
+    for (float v : log.latencyMs) if (v >= 0.0f) lat.push_back(v);
+    s.latencySamples = lat.size();
+    sort(lat.begin(), lat.end());
+    s.latencyP50 = percentile(lat, 0.50);
+    s.latencyP90 = percentile(lat, 0.90);
+    s.latencyP99 = percentile(lat, 0.99);
+    s.latencyMax = lat.empty() ? 0.0 : lat.back();
+    return s;
+}
+
+bool frameLogWriteCsv(const FrameLog &log, const string &path) {
+    FILE *f = fopen(path.c_str(), "w");
+    if (!f) return false;
+    fprintf(f, "frame,interval_ms,latency_ms\n");
+    for (size_t i = 0; i < log.intervalMs.size(); ++i) {
+        if (log.latencyMs[i] >= 0.0f) fprintf(f, "%zu,%.4f,%.4f\n", i, log.intervalMs[i], log.latencyMs[i]);
+        else fprintf(f, "%zu,%.4f,\n", i, log.intervalMs[i]);
+    }
+    return fclose(f) == 0;
+}
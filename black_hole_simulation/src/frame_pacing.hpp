@@ -0,0 +1,51 @@
+// frame_pacing.hpp
+// Frame limiter and input-latency log (no GL / GLFW dependency).
+//  - FramePacer waits for fixed frame slots of 1/fps. Most of the wait is an OS sleep;
+//    the last spinMargin seconds are a busy-wait on the steady clock, so the wake-up
+//    does not depend on the scheduler tick. The margin follows the measured oversleep.
+//  - FrameLog records per-frame interval and input-to-swap latency. Input callbacks
+//    stamp the oldest event not yet shown; the next frame picks it up and the swap that
+//    ends that frame closes it. Export as CSV to compare settings.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+double pacingNow();   // seconds on the steady clock
+
+struct FramePacer {
+    double fps = 0.0;             // 0 = uncapped
+    double spinMargin = 0.002;    // seconds spun before each deadline
+    double oversleep = 0.0;       // smoothed sleep overshoot
+    double nextDeadline = 0.0;
+};
+
+void framePacerSetRate(FramePacer &p, double fps);
+// Blocks until the next frame slot (returns at once when uncapped). Slots advance by
+// whole periods from the previous deadline; after a long stall they restart from now.
+void framePacerWait(FramePacer &p);
+
+struct FrameLog {
+    std::vector<float> intervalMs;   // swap-to-swap time
+    std::vector<float> latencyMs;    // input-to-swap, < 0 when the frame reflected no input
+    size_t maxFrames = size_t(1) << 20;
+    double lastSwap = 0.0;
+    double pendingInput = 0.0;       // oldest input not yet picked up by a frame
+    double inFlightInput = 0.0;      // input the current frame is drawing
+};
+
+void frameLogInput(FrameLog &log, double t);    // from input callbacks
+void frameLogBegin(FrameLog &log);              // after polling events, before drawing
+void frameLogSwapped(FrameLog &log, double t);  // right after the buffer swap
+
+struct FrameLogSummary {
+    size_t frames = 0, latencySamples = 0;
+    double intervalMean = 0.0, intervalP99 = 0.0;
+    double latencyP50 = 0.0, latencyP90 = 0.0, latencyP99 = 0.0, latencyMax = 0.0;
+};
+FrameLogSummary frameLogSummary(const FrameLog &log);
+
+// frame,interval_ms,latency_ms (latency empty when the frame had no input)
+bool frameLogWriteCsv(const FrameLog &log, const std::string &path);
@@ -0,0 +1,217 @@
+// geodesic.cpp
+// Batched Schwarzschild geodesic integrator, see geodesic.hpp.
+
+#include "geodesic.hpp"
+#include "parallel_for.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// One particle per "lane", for the mixed policy whose state and forces have different
+// widths in vfloat / vdouble
+template <class T>
+struct ScalarLane {
+    static const int width = 1;
+    T v;
+    ScalarLane() {}
+    explicit ScalarLane(T s) : v(s) {}
+    static ScalarLane load(const T *p) { return ScalarLane(*p); }
+    void store(T *p) const { *p = v; }
+};
+template <class T> ScalarLane<T> operator+(ScalarLane<T> a, ScalarLane<T> b) { return ScalarLane<T>(a.v + b.v); }
+template <class T> ScalarLane<T> operator-(ScalarLane<T> a, ScalarLane<T> b) { return ScalarLane<T>(a.v - b.v); }
+template <class T> ScalarLane<T> operator*(ScalarLane<T> a, ScalarLane<T> b) { return ScalarLane<T>(a.v * b.v); }
+template <class T> ScalarLane<T> operator/(ScalarLane<T> a, ScalarLane<T> b) { return ScalarLane<T>(a.v / b.v); }
+template <class T> ScalarLane<T>& operator+=(ScalarLane<T> &a, ScalarLane<T> b) { a.v += b.v; return a; }
+template <class T> ScalarLane<T> vsqrt(ScalarLane<T> a) { return ScalarLane<T>(std::sqrt(a.v)); }
+template <class T> ScalarLane<T> vmax(ScalarLane<T> a, ScalarLane<T> b) { return ScalarLane<T>(a.v < b.v ? b.v : a.v); }
+template <class T> ScalarLane<T> vselectLess(ScalarLane<T> a, ScalarLane<T> b, ScalarLane<T> t, ScalarLane<T> f) {
+    return a.v < b.v ? t : f;
+}
+
+// Lane types the kernel runs on per policy
+template <class P> struct GeodesicLanes;
+template <> struct GeodesicLanes<FloatPrecision> { using Compute = vfloat; using Accum = vfloat; };
+template <> struct GeodesicLanes<DoublePrecision> { using Compute = vdouble; using Accum = vdouble; };
+template <> struct GeodesicLanes<MixedPrecision> { using Compute = ScalarLane<float>; using Accum = ScalarLane<double>; };
+
+// Between the policy's Compute and Accum lanes: nothing to do when they are the same
+template <class To>
+struct LaneCast {
+    static To from(const To &v) { return v; }
+    template <class From> static To from(const From &v) { return To(v.v); }
+};
+
+template <class P>
+size_t laneWidth() { return GeodesicLanes<P>::Accum::width; }
+
+// Padding lanes sit far away, at rest and already "captured", so they never move.
+template <class P>
+void appendLane(GeodesicBatchT<P> &b) {
+    using Real = typename P::Accum;
+    size_t i = b.count++;
+    const size_t W = laneWidth<P>();
+    size_t padded = (b.count + W - 1) / W * W;
+    if (b.x.size() < padded) {
+        b.x.resize(padded, Real(1e4)); b.y.resize(padded, Real(0)); b.z.resize(padded, Real(0));
+        b.vx.resize(padded, Real(0)); b.vy.resize(padded, Real(0)); b.vz.resize(padded, Real(0));
+        b.h2.resize(padded, Real(0)); b.E0.resize(padded, Real(1)); b.L0.resize(padded, Real(0));
+        b.t.resize(padded, Real(0)); b.alive.resize(padded, Real(0));
+    }
+    b.alive[i] = Real(1);
+    b.t[i] = Real(0);
+}
+
+template <class P>
+void finishLane(GeodesicBatchT<P> &b, size_t i) {
+    using Real = typename P::Accum;
+    Real cx = b.y[i]*b.vz[i] - b.z[i]*b.vy[i];
+    Real cy = b.z[i]*b.vx[i] - b.x[i]*b.vz[i];
+    Real cz = b.x[i]*b.vy[i] - b.y[i]*b.vx[i];
+    b.h2[i] = cx*cx + cy*cy + cz*cz;
+    double E, L;
+    geodesicInvariants(b, i, E, L);
+    b.E0[i] = Real(E);
+    b.L0[i] = Real(L);
+}
+
+// One chunk of lanes, kept in registers for all steps. Forces in Compute lanes from
+// the positions, kicks / drifts / clock in Accum lanes.
+template <class P>
+void stepChunk(GeodesicBatchT<P> &b, size_t base, double dl, int steps) {
+    using C = typename GeodesicLanes<P>::Compute;
+    using A = typename GeodesicLanes<P>::Accum;
+    using CS = typename P::Compute;
+    using AS = typename P::Accum;
+    const C M(CS(b.M)), kappa(CS(b.kind == GeodesicKind::Timelike ? 1 : 0));
+    const C three(CS(3)), oneC(CS(1)), zeroC(CS(0));
+    const A one(AS(1)), two(AS(2)), zero(AS(0)), MA(b.M);
+    const A halfStep = A(AS(0.5 * dl)), fullStep = A(AS(dl));
+    const A horizon(CS(2) * CS(b.M) * CS(1.001));
+    A x = A::load(&b.x[base]), y = A::load(&b.y[base]), z = A::load(&b.z[base]);
+    A vx = A::load(&b.vx[base]), vy = A::load(&b.vy[base]), vz = A::load(&b.vz[base]);
+    A t = A::load(&b.t[base]);
+    const C h2 = LaneCast<C>::from(A::load(&b.h2[base]));
+    const A E = A::load(&b.E0[base]);
+    A alive = A::load(&b.alive[base]);
+
+    auto accel = [&](A &ax, A &ay, A &az, A &rOut) {
+        C px = LaneCast<C>::from(x), py = LaneCast<C>::from(y), pz = LaneCast<C>::from(z);
+        C r2 = px*px + py*py + pz*pz;
+        C r = vsqrt(r2);
+        C invR2 = oneC / r2;
+        C k = M * invR2 / r * (kappa + three * h2 * invR2);
+        ax = LaneCast<A>::from(zeroC - px * k);
+        ay = LaneCast<A>::from(zeroC - py * k);
+        az = LaneCast<A>::from(zeroC - pz * k);
+        rOut = LaneCast<A>::from(r);
+    };
+
+    A ax, ay, az, r;
+    accel(ax, ay, az, r);
+    for (int s = 0; s < steps; ++s) {
+        // captured lanes get a zero step and stay frozen
+        A hdt = halfStep * alive, dt = fullStep * alive;
+        vx += ax * hdt; vy += ay * hdt; vz += az * hdt;
+        x += vx * dt; y += vy * dt; z += vz * dt;
+        accel(ax, ay, az, r);
+        vx += ax * hdt; vy += ay * hdt; vz += az * hdt;
+        // dt/dλ = E / (1 - 2M/r)
+        t += E * dt / vmax(one - two * MA / r, A(AS(1e-6)));
+        alive = vselectLess(r, horizon, zero, alive);
+    }
+    x.store(&b.x[base]); y.store(&b.y[base]); z.store(&b.z[base]);
+    vx.store(&b.vx[base]); vy.store(&b.vy[base]); vz.store(&b.vz[base]);
+    t.store(&b.t[base]);
+    alive.store(&b.alive[base]);
+}
+
+} // namespace
+
+template <class P>
+void geodesicAddOrbit(GeodesicBatchT<P> &b, double rIn, double inclination, double phase, double speedFactor) {
+    using Real = typename P::Accum;
+    size_t i = b.count;
+    appendLane(b);
+    const Real M = b.M, r = Real(rIn);
+    // circular orbit: L = r sqrt(M / (r - 3M)), tangential dx/dτ = L / r
+    Real vCirc = (r > Real(3) * M) ? sqrt(M / (r - Real(3) * M)) : Real(0);
+    Real v = vCirc * Real(speedFactor);
+    Real ci = cos(Real(inclination)), si = sin(Real(inclination));
+    Real cp = cos(Real(phase)), sp = sin(Real(phase));
+    // orbit in the x-z plane, then tilted around x
+    Real px = r * cp, pz = r * sp;
+    Real ux = -sp * v, uz = cp * v;
+    b.x[i] = px; b.y[i] = -pz * si; b.z[i] = pz * ci;
+    b.vx[i] = ux; b.vy[i] = -uz * si; b.vz[i] = uz * ci;
+    finishLane(b, i);
+}
+
+template <class P>
+void geodesicAddRay(GeodesicBatchT<P> &b, const typename P::Accum p[3], const typename P::Accum d[3]) {
+    using Real = typename P::Accum;
+    size_t i = b.count;
+    appendLane(b);
+    Real n = sqrt(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+    if (n <= Real(0)) n = Real(1);
+    b.x[i] = p[0]; b.y[i] = p[1]; b.z[i] = p[2];
+    b.vx[i] = d[0] / n; b.vy[i] = d[1] / n; b.vz[i] = d[2] / n;
+    finishLane(b, i);
+}
+
+template <class P>
+void geodesicInvariants(const GeodesicBatchT<P> &b, size_t i, double &E, double &L) {
+    double x = b.x[i], y = b.y[i], z = b.z[i];
+    double vx = b.vx[i], vy = b.vy[i], vz = b.vz[i];
+    double r = sqrt(x*x + y*y + z*z);
+    double cx = y*vz - z*vy, cy = z*vx - x*vz, cz = x*vy - y*vx;
+    L = sqrt(cx*cx + cy*cy + cz*cz);
+    double vr = (x*vx + y*vy + z*vz) / r;
+    double kappa = (b.kind == GeodesicKind::Timelike) ? 1.0 : 0.0;
+    // E^2 = (dr/dλ)^2 + (1 - 2M/r)(kappa + L^2/r^2)
+    double e2 = vr*vr + (1.0 - 2.0 * b.M / r) * (kappa + L*L / (r*r));
+    E = sqrt(max(e2, 0.0));
+}
+
+template <class P>
+void geodesicStep(GeodesicBatchT<P> &b, double dlambda, int steps, unsigned threads) {
+    const size_t W = laneWidth<P>();
+    size_t chunks = (b.count + W - 1) / W;
+    parallelFor(chunks, threads, [&](size_t cb, size_t ce, unsigned) {
+        for (size_t c = cb; c < ce; ++c) stepChunk(b, c * W, dlambda, steps);
+    }, 64);
+}
+
+template <class P>
+GeodesicDrift geodesicMeasureDrift(const GeodesicBatchT<P> &b) {
+    GeodesicDrift d;
+    double sumE = 0.0;
+    for (size_t i = 0; i < b.count; ++i) {
+        if (b.alive[i] < 0.5f) { ++d.captured; continue; }
+        ++d.alive;
+        double E, L;
+        geodesicInvariants(b, i, E, L);
+        double relE = fabs(E - b.E0[i]) / max(1e-12, (double)b.E0[i]);
+        double relL = fabs(L - b.L0[i]) / max(1e-12, (double)b.L0[i]);
+        d.maxRelE = max(d.maxRelE, relE);
+        d.maxRelL = max(d.maxRelL, relL);
+        sumE += relE;
+    }
+    if (d.alive > 0) d.meanRelE = sumE / d.alive;
+    return d;
+}
+
+#define BH_GEODESIC_INSTANTIATE(P) \
+    template void geodesicAddOrbit<P>(GeodesicBatchT<P>&, double, double, double, double); \
+    template void geodesicAddRay<P>(GeodesicBatchT<P>&, const P::Accum*, const P::Accum*); \
+    template void geodesicInvariants<P>(const GeodesicBatchT<P>&, size_t, double&, double&); \
+    template void geodesicStep<P>(GeodesicBatchT<P>&, double, int, unsigned); \
+    template GeodesicDrift geodesicMeasureDrift<P>(const GeodesicBatchT<P>&);
+BH_GEODESIC_INSTANTIATE(FloatPrecision)
+BH_GEODESIC_INSTANTIATE(DoublePrecision)
+BH_GEODESIC_INSTANTIATE(MixedPrecision)
@@ -0,0 +1,83 @@
+// geodesic.hpp
+// Batched Schwarzschild geodesics for test particles (timelike) and photons (null).
+//
+// Geometrized units (G = c = 1, hole mass M). Motion stays in the plane spanned by
+// x and dx/dλ, and can be written in Cartesian-like coordinates as
+//     d2x/dλ2 = -M x / r^3 * (kappa + 3 h^2 / r^2),    h = |x × dx/dλ| (conserved)
+// with kappa = 1 for massive bodies (λ = proper time) and kappa = 0 for photons
+// (λ = affine parameter). This reproduces the exact radial equation
+//     r'' = -M/r^2 + h^2/r^3 - 3 M h^2/r^4
+// so periapsis precession and the plunge inside the ISCO (r = 6M) come out right.
+// Since h is fixed per particle the acceleration depends on position only and the
+// leapfrog step is symplectic.
+//
+// The batch and the kernel are templated on a precision policy (precision.hpp): the
+// state is kept in P::Accum, the accelerations evaluated in P::Compute. GeodesicBatch,
+// what the renderer runs, is the float instantiation, stepped vfloat::width particles
+// at a time; the double one runs on vdouble, the mixed one (float forces, double
+// state) one particle at a time. Instantiated for the three policies of precision.hpp.
+
+#pragma once
+
+#include "precision.hpp"
+
+#include <cstddef>
+#include <vector>
+
+enum class GeodesicKind { Timelike, Null };
+
+template <class P>
+struct GeodesicBatchT {
+    using Real = typename P::Accum;
+    GeodesicKind kind = GeodesicKind::Timelike;
+    Real M = 1;
+    size_t count = 0;                       // live entries; arrays are padded to the SIMD width
+
+    std::vector<Real> x, y, z;
+    std::vector<Real> vx, vy, vz;           // dx/dλ
+    std::vector<Real> h2;                   // conserved |x × v|^2
+    std::vector<Real> E0, L0;               // conserved energy / angular momentum at start
+    std::vector<Real> t;                    // coordinate time (timelike: dt/dτ = E / (1 - 2M/r))
+    std::vector<Real> alive;                // 1 while outside the horizon, 0 once captured
+};
+
+using GeodesicBatch = GeodesicBatchT<FloatPrecision>;
+
+struct GeodesicDrift {
+    double maxRelE = 0.0, meanRelE = 0.0;   // |E - E0| / E0 over live particles
+    double maxRelL = 0.0;                   // |L - L0| / L0
+    size_t alive = 0, captured = 0;
+};
+
+// Adds one particle at radius r (units of M) on an orbit tilted by `inclination` around
+// the x axis, at orbital phase `phase`. speedFactor = 1 gives the circular orbit speed
+// (needs r > 3M); < 1 makes it eccentric (precessing) or plunging. The setup math runs
+// in P::Accum.
+template <class P>
+void geodesicAddOrbit(GeodesicBatchT<P> &b, double r, double inclination, double phase, double speedFactor);
+
+// Adds a photon at position p moving along direction d (normalized internally).
+template <class P>
+void geodesicAddRay(GeodesicBatchT<P> &b, const typename P::Accum p[3], const typename P::Accum d[3]);
+
+// Energy / angular momentum per unit mass of particle i from its current state.
+template <class P>
+void geodesicInvariants(const GeodesicBatchT<P> &b, size_t i, double &E, double &L);
+
+// `steps` leapfrog steps of size dlambda for every particle (threads = 0: one per core).
+template <class P>
+void geodesicStep(GeodesicBatchT<P> &b, double dlambda, int steps, unsigned threads = 0);
+
+template <class P>
+GeodesicDrift geodesicMeasureDrift(const GeodesicBatchT<P> &b);
+
+#define BH_GEODESIC_EXTERN(P) \
+    extern template void geodesicAddOrbit<P>(GeodesicBatchT<P>&, double, double, double, double); \
+    extern template void geodesicAddRay<P>(GeodesicBatchT<P>&, const P::Accum*, const P::Accum*); \
+    extern template void geodesicInvariants<P>(const GeodesicBatchT<P>&, size_t, double&, double&); \
+    extern template void geodesicStep<P>(GeodesicBatchT<P>&, double, int, unsigned); \
+    extern template GeodesicDrift geodesicMeasureDrift<P>(const GeodesicBatchT<P>&);
+BH_GEODESIC_EXTERN(FloatPrecision)
+BH_GEODESIC_EXTERN(DoublePrecision)
+BH_GEODESIC_EXTERN(MixedPrecision)
+#undef BH_GEODESIC_EXTERN
@@ -0,0 +1,76 @@
+// grid_bench.cpp
+// Timing + consistency check of the background grid builders (no window, no GL).
+// Usage: grid_bench [zoomSteps=400] [maxDepth=6] [repeats=20]
+// Zooms the camera radius from 40 down to 0.5 (the scroll clamp) and back in `zoomSteps`
+// log steps, updating one AdaptiveGrid incrementally like the renderer does, and times
+// the rebuilds. Exits with status 1 if any mesh on the way has more vertices than the
+// vertex budget (the uniform lattice's count), or if the tree that comes back to the
+// start radius gives a different mesh from a fresh one built there.
+
+#include "spacetime_grid.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static bool sameGeometry(const GridGeometry &a, const GridGeometry &b) {
+    return a.verts.size() == b.verts.size() && a.indices.size() == b.indices.size() &&
+           memcmp(a.verts.data(), b.verts.data(), a.verts.size() * sizeof(GridVertex)) == 0 &&
+           memcmp(a.indices.data(), b.indices.data(), a.indices.size() * sizeof(unsigned int)) == 0;
+}
+
+int main(int argc, char** argv) {
+    int zoomSteps = argc > 1 ? atoi(argv[1]) : 400;
+    int maxDepth = argc > 2 ? atoi(argv[2]) : 6;
+    int repeats = argc > 3 ? atoi(argv[3]) : 20;
+    if (zoomSteps < 2) zoomSteps = 2;
+    if (maxDepth < 1) maxDepth = 1;
+    if (repeats < 1) repeats = 1;
+    const float rFar = 40.0f, rNear = 0.5f;
+
+    // uniform lattice of the renderer
+    GridGeometry uniform;
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        generateGridGeometry(uniform, 28, 0.12f, 3.2f);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    printf("uniform 57x57: verts=%zu edges=%zu best=%.3f ms\n", uniform.verts.size(), uniform.indices.size() / 2, best);
+
+    AdaptiveGrid ag;
+    ag.maxDepth = maxDepth;
+    updateAdaptiveGrid(ag, rFar);
+    int rebuilds = 0;
+    size_t maxVerts = 0;
+    double total = 0.0, worst = 0.0;
+    for (int i = 1; i <= 2 * zoomSteps; ++i) {
+        // down to rNear at i = zoomSteps, back to rFar at 2 * zoomSteps
+        float u = i <= zoomSteps ? float(i) / zoomSteps : float(2 * zoomSteps - i) / zoomSteps;
+        float radius = rFar * std::pow(rNear / rFar, u);
+        auto t0 = std::chrono::steady_clock::now();
+        bool rebuilt = updateAdaptiveGrid(ag, radius);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        total += ms;
+        if (!rebuilt) continue;
+        ++rebuilds;
+        if (ms > worst) worst = ms;
+        if (ag.geometry.verts.size() > maxVerts) maxVerts = ag.geometry.verts.size();
+    }
+    printf("adaptive depth=%d: %d updates, %d rebuilds, %.3f ms total, %.3f ms/rebuild, worst %.3f ms, max verts=%zu, nodes=%zu\n",
+           maxDepth, 2 * zoomSteps, rebuilds, total, rebuilds ? total / rebuilds : 0.0, worst, maxVerts, ag.nodes.size());
+
+    AdaptiveGrid fresh;
+    fresh.maxDepth = maxDepth;
+    updateAdaptiveGrid(fresh, rFar);
+    bool same = sameGeometry(ag.geometry, fresh.geometry);
+    printf("radius %.1f: leaves=%d verts=%zu edges=%zu, %s\n", rFar, ag.leafCount, ag.geometry.verts.size(),
+           ag.geometry.indices.size() / 2, same ? "matches a fresh build" : "MISMATCH with a fresh build");
+    bool inBudget = ag.vertexBudget <= 0 || maxVerts <= (size_t)ag.vertexBudget;
+    printf("vertex budget %d (uniform %zu): max verts=%zu, %s\n", ag.vertexBudget, uniform.verts.size(), maxVerts,
+           inBudget ? "within budget" : "OVER BUDGET");
+    return same && inBudget ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// mesh_bench.cpp
+// Regression + timing check of the CPU point cloud generators (no window, no GL).
+// Usage: mesh_bench [scale=64] [threads=0] [repeats=5] [ringRef] [diskRef]
+// Builds the default ring / disk clouds and a `scale`x denser version, with 1 and
+// `threads` threads. The FNV hashes must agree between runs and thread counts, and the
+// fingerprints (pixelFingerprint, stable across libm implementations) must match the
+// reference ones: the renderer's defaults and scale 64 have theirs built in, other
+// scales are checked only when ringRef / diskRef ("count,projection,norm" as printed,
+// scaled cases) are given. Any difference exits with status 1.
+//
+// Usage: mesh_bench bh [res=1000] [legacy|direct] [threads=0]
+// Time and peak RSS of building the BH pixel disc into a VBO-sized buffer: `legacy` is
+// the old push_back loop followed by the upload copy, `direct` the exact-count fill
+// into the destination. Run once per mode, RSS is per process.
+
+#include "mesh_gen.hpp"
+#include "parallel_for.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+static const uint64_t kSeed = 0x5eedb1ac4401eull;   // MESH_SEED in black_hole.cpp
+
+// Fingerprints of the clouds for kSeed; change them only with an intended output change
+static PixelFingerprint fingerprint(size_t count, double projection, double norm) {
+    PixelFingerprint f;
+    f.count = count; f.projection = projection; f.norm = norm;
+    return f;
+}
+static const PixelFingerprint kRingRef = fingerprint(5040, -991.98900602455251, 1468.2423487848557);         // ring 720
+static const PixelFingerprint kDiskRef = fingerprint(38880, -7184.5217564334162, 3953.5800997115771);        // disk 36x360
+static const int kDefaultScale = 64;
+static const PixelFingerprint kRingScaledRef = fingerprint(322560, -16156.648558254838, 11745.80100764851);   // ring, scale 64
+static const PixelFingerprint kDiskScaledRef = fingerprint(2488320, 20745.692928161821, 31628.909241890477);  // disk, scale 64
+
+// "count,projection,norm"; count 0 = no reference
+static PixelFingerprint parseFingerprint(const char *s) {
+    unsigned long long count = 0;
+    double projection = 0.0, norm = 0.0;
+    if (sscanf(s, "%llu,%lf,%lf", &count, &projection, &norm) != 3) {
+        fprintf(stderr, "bad reference %s, expected count,projection,norm\n", s);
+        count = 0;
+    }
+    return fingerprint((size_t)count, projection, norm);
+}
+
+static double timeBest(int repeats, const std::function<void()> &fn) {
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+static double peakRssMiB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0.0;
+    return pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / (1024.0 * 1024.0);   // bytes
+#else
+    return ru.ru_maxrss / 1024.0;              // KiB
+#endif
+#endif
+}
+
+// The generator as it was before exact counts: push_back without reserve
+static void legacyBlackHolePixels(std::vector<Pixel> &pixels, int res, float radius) {
+    pixels.clear();
+    for (int j=0;j<res;++j){
+        for (int i=0;i<res;++i){
+            float u = (i + 0.5f)/float(res)*2.0f - 1.0f;
+            float v = (j + 0.5f)/float(res)*2.0f - 1.0f;
+            float x = u * radius;
+            float y = v * radius;
+            if (std::sqrt(x*x + y*y) <= radius) {
+                Pixel p;
+                p.x = x; p.y = y; p.z = 0.01f;
+                p.r = 0.0f; p.g = 0.0f; p.b = 0.0f; p.a = 1.0f;
+                pixels.push_back(p);
+            }
+        }
+    }
+}
+
+static int benchBlackHole(int res, bool legacy, unsigned threads) {
+    const float radius = 0.65f;     // BH_RADIUS
+    double rss0 = peakRssMiB();
+    auto t0 = std::chrono::steady_clock::now();
+    // stands in for the VBO: allocated at the final size, like glBufferData(nullptr)
+    std::unique_ptr<Pixel[]> vbo;
+    size_t count = 0;
+    if (legacy) {
+        std::vector<Pixel> pixels;
+        legacyBlackHolePixels(pixels, res, radius);
+        count = pixels.size();
+        vbo.reset(new Pixel[count]);
+        memcpy(vbo.get(), pixels.data(), count * sizeof(Pixel));   // glBufferData copy
+    } else {
+        BlackHolePixelLayout layout;
+        blackHolePixelLayout(layout, res, radius);
+        count = layout.count;
+        vbo.reset(new Pixel[count]);
+        fillBlackHolePixels(vbo.get(), layout, threads);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    uint64_t h = 0xcbf29ce484222325ull;
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(vbo.get());
+    for (size_t i = 0; i < count * sizeof(Pixel); ++i) { h ^= bytes[i]; h *= 0x100000001b3ull; }
+    printf("bh res=%d mode=%s threads=%u points=%zu time=%.2f ms peakRSS=%.1f MiB (+%.1f) buffer=%.1f MiB hash=%016llx\n",
+           res, legacy ? "legacy" : "direct", legacy ? 1u : threads, count, ms, peakRssMiB(), peakRssMiB() - rss0,
+           count * sizeof(Pixel) / (1024.0 * 1024.0), (unsigned long long)h);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "bh") == 0) {
+        int res = argc > 2 ? atoi(argv[2]) : 1000;
+        bool legacy = argc > 3 && strcmp(argv[3], "legacy") == 0;
+        unsigned threads = resolveThreadCount(argc > 4 ? (unsigned)atoi(argv[4]) : 0);
+        return benchBlackHole(res > 0 ? res : 1, legacy, threads);
+    }
+    int scale = argc > 1 ? atoi(argv[1]) : 64;
+    unsigned threads = resolveThreadCount(argc > 2 ? (unsigned)atoi(argv[2]) : 0);
+    int repeats = argc > 3 ? atoi(argv[3]) : 5;
+    if (scale < 1) scale = 1;
+    if (repeats < 1) repeats = 1;
+    PixelFingerprint ringScaled = scale == kDefaultScale ? kRingScaledRef : PixelFingerprint();
+    PixelFingerprint diskScaled = scale == kDefaultScale ? kDiskScaledRef : PixelFingerprint();
+    if (argc > 4) ringScaled = parseFingerprint(argv[4]);
+    if (argc > 5) diskScaled = parseFingerprint(argv[5]);
+
+    struct Case {
+        const char *name;
+        PixelFingerprint expected;
+        std::function<void(std::vector<Pixel>&, unsigned)> gen;
+    };
+    // the renderer's defaults, then `scale` times more points (disk: 8x the angles, scale/8 x the rings)
+    const int diskRings = scale * 36 / 8 > 0 ? scale * 36 / 8 : 1;
+    const Case cases[] = {
+        { "ring 720",    kRingRef,   [](std::vector<Pixel> &o, unsigned t) { generatePhotonRingPixels(o, 0.52f, 0.6175f, 720, kSeed, t); } },
+        { "disk 36x360", kDiskRef,   [](std::vector<Pixel> &o, unsigned t) { generateDiskPixels(o, 0.5f, 0.95f, 0.04f, 36, 360, -0.28f, kSeed, t); } },
+        { "ring scaled", ringScaled, [scale](std::vector<Pixel> &o, unsigned t) { generatePhotonRingPixels(o, 0.52f, 0.6175f, 720 * scale, kSeed, t); } },
+        { "disk scaled", diskScaled, [diskRings](std::vector<Pixel> &o, unsigned t) { generateDiskPixels(o, 0.5f, 0.95f, 0.04f, diskRings, 360 * 8, -0.28f, kSeed, t); } },
+    };
+
+    printf("scale=%d threads=%u repeats=%d\n", scale, threads, repeats);
+    printf("%-12s %10s %16s %10s %10s %8s\n", "case", "points", "hash", "1T ms", "NT ms", "speedup");
+    bool ok = true;
+    for (const Case &c : cases) {
+        std::vector<Pixel> serial, parallel, again;
+        double ms1 = timeBest(repeats, [&] { c.gen(serial, 1); });
+        double msN = timeBest(repeats, [&] { c.gen(parallel, threads); });
+        c.gen(again, threads);
+        uint64_t h1 = hashPixels(serial), hN = hashPixels(parallel), hA = hashPixels(again);
+        bool same = serial.size() == parallel.size() && h1 == hN && hN == hA;
+        PixelFingerprint fp = pixelFingerprint(serial);
+        bool reference = c.expected.count == 0 || pixelFingerprintMatch(fp, c.expected);
+        ok = ok && same && reference;
+        printf("%-12s %10zu %016llx %10.2f %10.2f %7.2fx%s%s\n", c.name, serial.size(),
+               (unsigned long long)h1, ms1, msN, ms1 / msN, same ? "" : "  MISMATCH",
+               c.expected.count == 0 ? "  (no reference)" : reference ? "" : "  REFERENCE MISMATCH");
+        printf("%-12s fingerprint %zu,%.17g,%.17g\n", "", fp.count, fp.projection, fp.norm);
+        if (!reference)
+            fprintf(stderr, "%s: fingerprint %zu,%.17g,%.17g, expected %zu,%.17g,%.17g\n", c.name, fp.count,
+                    fp.projection, fp.norm, c.expected.count, c.expected.projection, c.expected.norm);
+    }
+    printf(ok ? "outputs match\n" : "mismatch between runs / thread counts / reference\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// mesh_gen.cpp
+// Pixel point cloud generators, see mesh_gen.hpp.
+
+#include "mesh_gen.hpp"
+#include "parallel_for.hpp"
+#include "rng.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace std;
+
+namespace {
+
+// RNG streams, one per generator
+enum : uint64_t { kStreamRing = 1, kStreamDisk = 2 };
+
+inline float mixf(float a, float b, float t) { return a * (1.0f - t) + b * t; }
+
+inline float smoothstepf(float e0, float e1, float x) {
+    float t = min(max((x - e0) / (e1 - e0), 0.0f), 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+} // namespace
+
+// Cell centers inside the disc, with the same float expression the old per-cell loop used
+static inline bool insideDisc(int i, int j, int res, float radius) {
+    float u = (i + 0.5f)/float(res)*2.0f - 1.0f;
+    float v = (j + 0.5f)/float(res)*2.0f - 1.0f;
+    float x = u * radius;
+    float y = v * radius;
+    return sqrt(x*x + y*y) <= radius;
+}
+
+void blackHolePixelLayout(BlackHolePixelLayout &layout, int res, float radius) {
+    res = max(res, 0);
+    layout.res = res;
+    layout.radius = radius;
+    layout.rowBegin.assign(res, 0);
+    layout.rowEnd.assign(res, 0);
+    layout.rowOffset.assign(size_t(res) + 1, 0);
+    for (int j = 0; j < res; ++j) {
+        // analytic half-width of the row, then nudged onto the exact float predicate
+        float v = (j + 0.5f)/float(res)*2.0f - 1.0f;
+        float halfU = sqrt(max(0.0f, 1.0f - v*v));
+        int end = min(res, int(ceil((halfU + 1.0f) * 0.5f * res - 0.5f)) + 1);
+        while (end > 0 && !insideDisc(end - 1, j, res, radius)) --end;
+        while (end < res && insideDisc(end, j, res, radius)) ++end;
+        int begin = res - end;      // the row is symmetric around the center
+        while (begin < end && !insideDisc(begin, j, res, radius)) ++begin;
+        while (begin > 0 && insideDisc(begin - 1, j, res, radius)) --begin;
+        if (begin > end) begin = end;
+        layout.rowBegin[j] = begin;
+        layout.rowEnd[j] = end;
+        layout.rowOffset[j + 1] = layout.rowOffset[j] + size_t(end - begin);
+    }
+    layout.count = layout.rowOffset[res];
+}
+
+void fillBlackHolePixels(Pixel *out, const BlackHolePixelLayout &layout, unsigned threads) {
+    const int res = layout.res;
+    const float radius = layout.radius;
+    parallelFor(size_t(res), threads, [&](size_t jb, size_t je, unsigned) {
+        for (size_t j = jb; j < je; ++j) {
+            Pixel *row = out + layout.rowOffset[j];
+            float v = (j + 0.5f)/float(res)*2.0f - 1.0f;
+            for (int i = layout.rowBegin[j]; i < layout.rowEnd[j]; ++i) {
+                float u = (i + 0.5f)/float(res)*2.0f - 1.0f;
+                Pixel &p = *row++;
+                p.x = u * radius; p.y = v * radius; p.z = 0.01f;
+                p.r = 0.0f; p.g = 0.0f; p.b = 0.0f; p.a = 1.0f;
+            }
+        }
+    }, 64);
+}
+
+void generateBlackHolePixels(vector<Pixel> &out, int res, float radius, unsigned threads) {
+    BlackHolePixelLayout layout;
+    blackHolePixelLayout(layout, res, radius);
+    out.resize(layout.count);
+    fillBlackHolePixels(out.data(), layout, threads);
+}
+
+void generatePhotonRingPixels(vector<Pixel> &out, float inR, float outR, int samples,
+                              uint64_t seed, unsigned threads) {
+    out.resize(photonRingPixelCount(samples));
+    fillPhotonRingPixels(out.data(), inR, outR, samples, seed, threads);
+}
+
+void fillPhotonRingPixels(Pixel *out, float inR, float outR, int samples,
+                          uint64_t seed, unsigned threads) {
+    const int R = PH_RING_RADIAL_SAMPLES;
+    samples = max(samples, 0);
+    const CounterRng rng(seed, kStreamRing);
+    const float radialStep = (outR - inR) / float(R - 1);
+
+    parallelFor(size_t(samples), threads, [&](size_t sb, size_t se, unsigned) {
+        for (size_t s = sb; s < se; ++s) {
+            float a = (s + 0.5f)/float(samples) * 2.0f * float(M_PI);
+            float ca = cos(a), sa = sin(a);
+            for (int k = 0; k < R; ++k) {
+                size_t idx = s * R + k;
+                float rr = inR + k * radialStep + rng.centered(idx) * 0.004f;
+                float tt = (rr - inR) / (outR - inR);
+                Pixel &p = out[idx];
+                p.x = ca * rr;
+                p.y = sa * rr;
+                p.z = 0.0f;
+                p.r = 1.0f;
+                p.g = mixf(0.55f, 0.12f, tt);
+                p.b = mixf(0.08f, 0.02f, tt);
+                p.a = 0.95f * (0.6f + 0.6f * (1.0f - fabs(tt - 0.5f)));
+            }
+        }
+    }, 256);
+}
+
+void generateDiskPixels(vector<Pixel> &out, float innerR, float outerR, float thickness,
+                        int radialSteps, int angularSteps, float centerY,
+                        uint64_t seed, unsigned threads) {
+    out.resize(diskPixelCount(radialSteps, angularSteps));
+    fillDiskPixels(out.data(), innerR, outerR, thickness, radialSteps, angularSteps, centerY, seed, threads);
+}
+
+void fillDiskPixels(Pixel *out, float innerR, float outerR, float thickness,
+                    int radialSteps, int angularSteps, float centerY,
+                    uint64_t seed, unsigned threads) {
+    const int layers = 3;
+    radialSteps = max(radialSteps, 0);
+    angularSteps = max(angularSteps, 0);
+    const size_t cells = size_t(radialSteps) * angularSteps;
+    const CounterRng rng(seed, kStreamDisk);
+
+    // one jitter per (ring, angle) cell, shared by its layers
+    parallelFor(cells, threads, [&](size_t cb, size_t ce, unsigned) {
+        for (size_t c = cb; c < ce; ++c) {
+            int ri = int(c / angularSteps), ai = int(c % angularSteps);
+            float t = (ri+0.5f)/float(radialSteps);
+            float r = mixf(innerR, outerR, t);
+            float a = (ai + 0.5f)/float(angularSteps) * 2.0f * float(M_PI);
+            float rr = r + rng.centered(c) * 0.003f;
+            float radialNorm = smoothstepf(innerR, outerR, rr);
+            // inner (0.96, 0.12, 0.03) -> outer (1.0, 0.78, 0.18)
+            float cr = mixf(0.96f, 1.0f, radialNorm);
+            float cg = mixf(0.12f, 0.78f, radialNorm);
+            float cbl = mixf(0.03f, 0.18f, radialNorm);
+            float alpha = 0.92f * (0.6f + 0.6f*radialNorm);
+            float px = cos(a)*rr, pz = sin(a)*rr;
+            for (int yi = 0; yi < layers; ++yi) {
+                Pixel &p = out[c * layers + yi];
+                p.x = px;
+                p.y = centerY + (-thickness*0.35f + yi * (thickness*0.35f));
+                p.z = pz;
+                p.r = cr; p.g = cg; p.b = cbl; p.a = alpha;
+            }
+        }
+    }, 1024);
+}
+
+uint64_t hashPixels(const vector<Pixel> &pixels) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(pixels.data());
+    size_t n = pixels.size() * sizeof(Pixel);
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < n; ++i) { h ^= bytes[i]; h *= 0x100000001b3ull; }
+    return h;
+}
+
+PixelFingerprint pixelFingerprint(const vector<Pixel> &pixels) {
+    PixelFingerprint f;
+    f.count = pixels.size();
+    double sq = 0.0;
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        const Pixel &p = pixels[i];
+        double v = double(p.x) + 2.0*p.y + 3.0*p.z + 5.0*p.r + 7.0*p.g + 11.0*p.b + 13.0*p.a;
+        f.projection += (rngMix64(i + 0x9e3779b97f4a7c15ull) >> 63) ? v : -v;
+        sq += v * v;
+    }
+    f.norm = sqrt(sq);
+    return f;
+}
+
+bool pixelFingerprintMatch(const PixelFingerprint &a, const PixelFingerprint &b, double relTol) {
+    double tol = relTol * max(1.0, max(a.norm, b.norm));
+    return a.count == b.count && fabs(a.projection - b.projection) <= tol && fabs(a.norm - b.norm) <= tol;
+}
@@ -0,0 +1,77 @@
+// mesh_gen.hpp
+// CPU generation of the pixel point clouds (black hole disc, photon ring annulus,
+// accretion disk). No GL dependency: mesh_bench times and hashes them.
+//
+// Every generator knows its exact point count up front (xxxPixelCount), and the
+// fillXxx functions write straight into caller memory -- the renderer passes a mapped
+// VBO -- in parallel chunks. The vector versions are thin wrappers.
+//
+// Jitter comes from CounterRng keyed by the point index, so the output only depends
+// on the parameters and the seed: any thread count gives the same bytes.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Pixel {
+    float x,y,z;
+    float r,g,b,a;
+};
+
+// Radial samples per angle of the ring annulus (inR..outR inclusive)
+constexpr int PH_RING_RADIAL_SAMPLES = 7;
+
+// Black hole disc: the res x res cells whose center lies within `radius`. Each row
+// keeps a contiguous [begin, end) run of cells; rowOffset is the prefix sum of the
+// run lengths, so rows can be filled independently.
+struct BlackHolePixelLayout {
+    int res = 0;
+    float radius = 0.0f;
+    std::vector<int> rowBegin, rowEnd;
+    std::vector<size_t> rowOffset;      // res + 1 entries, rowOffset[res] = count
+    size_t count = 0;
+};
+void blackHolePixelLayout(BlackHolePixelLayout &layout, int res, float radius);
+void fillBlackHolePixels(Pixel *out, const BlackHolePixelLayout &layout, unsigned threads = 0);
+void generateBlackHolePixels(std::vector<Pixel> &out, int res, float radius, unsigned threads = 0);
+
+inline size_t photonRingPixelCount(int samples) {
+    return samples > 0 ? size_t(samples) * PH_RING_RADIAL_SAMPLES : 0;
+}
+inline size_t diskPixelCount(int radialSteps, int angularSteps) {
+    return (radialSteps > 0 && angularSteps > 0) ? size_t(radialSteps) * angularSteps * 3 : 0;
+}
+
+void fillPhotonRingPixels(Pixel *out, float inR, float outR, int samples,
+                          uint64_t seed, unsigned threads = 0);
+void fillDiskPixels(Pixel *out, float innerR, float outerR, float thickness,
+                    int radialSteps, int angularSteps, float centerY,
+                    uint64_t seed, unsigned threads = 0);
+
+// Billboard-local annulus between inR and outR, `samples` angles x PH_RING_RADIAL_SAMPLES
+void generatePhotonRingPixels(std::vector<Pixel> &out, float inR, float outR, int samples,
+                              uint64_t seed, unsigned threads = 0);
+
+// Horizontal disk in world coordinates at height centerY, 3 layers across the thickness
+void generateDiskPixels(std::vector<Pixel> &out, float innerR, float outerR, float thickness,
+                        int radialSteps, int angularSteps, float centerY,
+                        uint64_t seed, unsigned threads = 0);
+
+// FNV-1a over the raw bytes, for regression checks
+uint64_t hashPixels(const std::vector<Pixel> &pixels);
+
+// Reference values kept in the source can't be byte hashes: a libm that rounds sin/cos
+// differently changes the bytes. This is a random projection instead: each pixel's
+// fields are mixed into one value, and the values are summed with a pseudo-random sign
+// per buffer position. Last-bit rounding differences cancel (~1e-7 of `norm`), while
+// moving, reordering or re-randomizing the points changes `projection` by a
+// sizeable fraction of `norm`, whatever the point count.
+struct PixelFingerprint {
+    size_t count = 0;
+    double projection = 0.0;
+    double norm = 0.0;          // sqrt of the sum of the squared mixed values
+};
+PixelFingerprint pixelFingerprint(const std::vector<Pixel> &pixels);
+bool pixelFingerprintMatch(const PixelFingerprint &a, const PixelFingerprint &b, double relTol = 1e-6);
@@ -0,0 +1,151 @@
+// metric.cpp
+// Metric helpers, see metric.hpp.
+//
+// - gravitational radius (rg) is used as a scale; we tie it to BH_RADIUS in scene units.
+// - "time dilation factor" w.r.t distant observer: sqrt(1 - Rs / r)  (0 < factor <= 1).
+//   We'll clamp to a safe domain to avoid NaNs when r <= Rs.
+// - "spatial distortion" is an approximate normalized deflection value using 4*rg/r (derived from 4GM/(rc^2) scaling).
+
+#include "metric.hpp"
+#include "parallel_for.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+float computeTimeDilationFactor(float rg_scene, float distance_from_center) {
+    // We treat rg_scene as the Schwarzschild radius scaled to scene units.
+    // Proper formula: sqrt(1 - Rs / r) ; Rs = 2GM/c^2. Here rg_scene acts as Rs for scaling.
+    float eps = 1e-4f;
+    float r = max(distance_from_center, rg_scene + eps);
+    float inside = 1.0f - rg_scene / r;
+    if (inside <= 0.0f) return 0.0f;
+    return sqrt(inside);
+}
+
+float computeSpatialDistortionApprox(float rg_scene, float distance_from_center) {
+    // approximate deflection scale alpha ~ 4GM/(r c^2) -> ~ 2*Rs/r -> we use factor = clamp(4*rg/r, 0..5)
+    float r = max(distance_from_center, 1e-4f);
+    float val = 4.0f * rg_scene / r;
+    // normalize to a visually useful range (0..1)
+    float normalized = val / (val + 1.0f); // maps 0..inf -> 0..1
+    return normalized;
+}
+
+float gridDisplacement(float r, float massScale) {
+    float A = 0.45f * massScale;
+    return -A / (r + 0.08f) * exp(-r*0.6f);
+}
+
+float gridDisplacementCurvature(float r, float massScale) {
+    float A = 0.45f * massScale;
+    float k = 0.6f;
+    float g = 1.0f / (r + 0.08f);
+    return A * exp(-k*r) * g * (2.0f*g*g + 2.0f*k*g + k*k);
+}
+
+// ---- Fields ----
+// Same operations in the same order as the scalar functions (max / sqrt / div are exact
+// in every lane type), so the float field matches them bit for bit.
+
+namespace {
+
+template <class V, class T>
+inline V fieldLanes(MetricField field, V rg, V r2) {
+    V r = vsqrt(r2);
+    if (field == MetricField::TimeDilation) {
+        r = vmax(r, rg + V(T(1e-4)));
+        return vsqrt(vmax(V(T(1)) - rg / r, V(T(0))));
+    }
+    V val = V(T(4)) * rg / vmax(r, V(T(1e-4)));
+    return val / (val + V(T(1)));
+}
+
+// Points [begin, end) in blocks of V::width; the last partial block goes through a padded copy
+template <class V, class T>
+void fieldPointsRange(MetricField field, T rg, const T c[3], const T *x, const T *y, const T *z,
+                      T *out, size_t begin, size_t end) {
+    const int W = V::width;
+    const V vrg(rg), cx(c[0]), cy(c[1]), cz(c[2]);
+    size_t i = begin;
+    for (; i + W <= end; i += W) {
+        V dx = V::load(x + i) - cx, dy = V::load(y + i) - cy;
+        V r2 = dx * dx + dy * dy;
+        if (z) { V dz = V::load(z + i) - cz; r2 = r2 + dz * dz; }
+        fieldLanes<V, T>(field, vrg, r2).store(out + i);
+    }
+    if (i == end) return;
+    T px[W], py[W], pz[W], po[W];
+    for (int k = 0; k < W; ++k) {
+        size_t j = std::min(i + k, end - 1);
+        px[k] = x[j]; py[k] = y[j]; pz[k] = z ? z[j] : c[2];
+    }
+    fieldPointsRange<V, T>(field, rg, c, px, py, z ? pz : nullptr, po, 0, W);
+    for (size_t k = 0; i + k < end; ++k) out[i + k] = po[k];
+}
+
+template <class V, class T>
+void fieldPoints(MetricField field, T rg, const T c[3], const T *x, const T *y, const T *z,
+                 T *out, size_t n, unsigned threads) {
+    const size_t W = V::width;
+    parallelFor((n + W - 1) / W, threads, [&](size_t b, size_t e, unsigned) {
+        fieldPointsRange<V, T>(field, rg, c, x, y, z, out, b * W, std::min(n, e * W));
+    }, 1024);
+}
+
+template <class V, class T>
+void fieldGrid(MetricField field, T rg, const T c[3], const T origin[3], const T step[3],
+               int nx, int ny, int nz, T *out, unsigned threads) {
+    if (nx <= 0 || ny <= 0 || nz <= 0) return;
+    const int W = V::width;
+    // lattice x coordinates padded to whole blocks
+    std::vector<T> xs(size_t(nx + W - 1) / W * W);
+    for (size_t i = 0; i < xs.size(); ++i) xs[i] = origin[0] + T(std::min<size_t>(i, nx - 1)) * step[0];
+    const size_t rows = size_t(ny) * nz;
+    parallelFor(rows, threads, [&](size_t rb, size_t re, unsigned) {
+        const V vrg(rg), cx(c[0]);
+        T tail[W];
+        for (size_t row = rb; row < re; ++row) {
+            T dy = origin[1] + T(row % ny) * step[1] - c[1];
+            T dz = origin[2] + T(row / ny) * step[2] - c[2];
+            const V dy2(dy * dy), dz2(dz * dz);
+            T *dst = out + row * nx;
+            for (int i = 0; i < nx; i += W) {
+                V dx = V::load(&xs[i]) - cx;
+                V f = fieldLanes<V, T>(field, vrg, dx * dx + dy2 + dz2);
+                if (i + W <= nx) { f.store(dst + i); continue; }
+                f.store(tail);
+                for (int k = 0; i + k < nx; ++k) dst[i + k] = tail[k];
+            }
+        }
+    }, 16);
+}
+
+} // namespace
+
+void evaluateMetricField(MetricField field, float rg, const float center[3],
+                         const float *x, const float *y, const float *z, float *out, size_t n,
+                         unsigned threads) {
+    fieldPoints<vfloat, float>(field, rg, center, x, y, z, out, n, threads);
+}
+
+void evaluateMetricField(MetricField field, double rg, const double center[3],
+                         const double *x, const double *y, const double *z, double *out, size_t n,
+                         unsigned threads) {
+    fieldPoints<vdouble, double>(field, rg, center, x, y, z, out, n, threads);
+}
+
+void evaluateMetricFieldGrid(MetricField field, float rg, const float center[3],
+                             const float origin[3], const float step[3], int nx, int ny, int nz,
+                             float *out, unsigned threads) {
+    fieldGrid<vfloat, float>(field, rg, center, origin, step, nx, ny, nz, out, threads);
+}
+
+void evaluateMetricFieldGrid(MetricField field, double rg, const double center[3],
+                             const double origin[3], const double step[3], int nx, int ny, int nz,
+                             double *out, unsigned threads) {
+    fieldGrid<vdouble, double>(field, rg, center, origin, step, nx, ny, nz, out, threads);
+}
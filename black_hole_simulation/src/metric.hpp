@@ -0,0 +1,43 @@
+// metric.hpp
+// Schwarzschild-flavoured scalar helpers used by the HUD and the background grid.
+// Display approximations in scene units, not a relativistic simulation (that is
+// geodesic.hpp). No GL dependency.
+
+#pragma once
+
+#include <cstddef>
+
+// Time dilation w.r.t. a distant observer, sqrt(1 - Rs / r) with rg_scene acting as
+// Rs; r is clamped just outside Rs, so the result is in (0, 1]
+float computeTimeDilationFactor(float rg_scene, float distance_from_center);
+
+// Light deflection ~ 4 rg / r, mapped from 0..inf to 0..1
+float computeSpatialDistortionApprox(float rg_scene, float distance_from_center);
+
+// Height of the background grid at distance r from the well center
+float gridDisplacement(float r, float massScale);
+
+// |d2y/dr2| of gridDisplacement (closed form), used to decide where the grid needs detail
+float gridDisplacementCurvature(float r, float massScale);
+
+// ---- Fields: the two functions above over many points in one call ----
+// SIMD lanes (simd.hpp) split over threads; threads == 0 means hardware_concurrency.
+// The float path gives the same bits as the scalar functions above.
+enum class MetricField { TimeDilation, SpatialDistortion };
+
+// out[i] = field at distance |(x[i], y[i], z[i]) - center|; z may be null for points
+// in the z = center[2] plane
+void evaluateMetricField(MetricField field, float rg, const float center[3],
+                         const float *x, const float *y, const float *z, float *out, size_t n,
+                         unsigned threads = 0);
+void evaluateMetricField(MetricField field, double rg, const double center[3],
+                         const double *x, const double *y, const double *z, double *out, size_t n,
+                         unsigned threads = 0);
+
+// Regular lattice origin + (i, j, k) * step, i fastest: out holds nx * ny * nz values
+void evaluateMetricFieldGrid(MetricField field, float rg, const float center[3],
+                             const float origin[3], const float step[3], int nx, int ny, int nz,
+                             float *out, unsigned threads = 0);
+void evaluateMetricFieldGrid(MetricField field, double rg, const double center[3],
+                             const double origin[3], const double step[3], int nx, int ny, int nz,
+                             double *out, unsigned threads = 0);
@@ -0,0 +1,404 @@
+// nbody.cpp
+// Barnes-Hut N-body integrator, see nbody.hpp.
+
+#include "nbody.hpp"
+#include "parallel_for.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace std;
+
+static double elapsedMs(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+}
+
+void NBodySystem::resize(size_t n) {
+    x.resize(n); y.resize(n); z.resize(n);
+    vx.resize(n); vy.resize(n); vz.resize(n);
+    ax.assign(n, 0.0f); ay.assign(n, 0.0f); az.assign(n, 0.0f);
+    mass.resize(n);
+    accelValid = false;
+}
+
+void nbodyInitOrbitingDisk(NBodySystem &s, size_t n, float centralMass, float starMass,
+                           float rInner, float rOuter, float thickness, uint32_t seed) {
+    s.resize(n);
+    if (n == 0) return;
+    mt19937 rng(seed);
+    uniform_real_distribution<float> uni(0.0f, 1.0f);
+    normal_distribution<float> gauss(0.0f, 1.0f);
+
+    s.x[0] = s.y[0] = s.z[0] = 0.0f;
+    s.vx[0] = s.vy[0] = s.vz[0] = 0.0f;
+    s.mass[0] = centralMass;
+
+    float diskMass = starMass * float(n - 1);
+    for (size_t i = 1; i < n; ++i) {
+        // uniform in area between rInner and rOuter
+        float u = uni(rng);
+        float r = sqrt(rInner*rInner + u * (rOuter*rOuter - rInner*rInner));
+        float a = uni(rng) * 2.0f * float(M_PI);
+        float h = gauss(rng) * thickness;
+        s.x[i] = cos(a) * r;
+        s.z[i] = sin(a) * r;
+        s.y[i] = h;
+        // circular speed from the central mass plus the disk mass inside r
+        float enclosed = centralMass + diskMass * (r*r - rInner*rInner) / (rOuter*rOuter - rInner*rInner);
+        float v = sqrt(s.params.G * enclosed / r);
+        s.vx[i] = -sin(a) * v;
+        s.vz[i] =  cos(a) * v;
+        s.vy[i] = 0.0f;
+        s.mass[i] = starMass;
+    }
+}
+
+// ========================================================
+// ================= Octree build =========================
+// ========================================================
+
+static inline int octantOf(float x, float y, float z, float cx, float cy, float cz) {
+    return (x >= cx ? 1 : 0) | (y >= cy ? 2 : 0) | (z >= cz ? 4 : 0);
+}
+
+// Counting sort of order[begin,end) by octant; writes the 9 bucket offsets.
+static void partitionOctants(NBodySystem &s, size_t begin, size_t end,
+                             float cx, float cy, float cz, size_t offsets[9]) {
+    size_t count[8] = {0};
+    for (size_t k = begin; k < end; ++k) {
+        uint32_t i = s.order[k];
+        ++count[octantOf(s.x[i], s.y[i], s.z[i], cx, cy, cz)];
+    }
+    offsets[0] = begin;
+    for (int o = 0; o < 8; ++o) offsets[o + 1] = offsets[o] + count[o];
+    size_t fill[8];
+    for (int o = 0; o < 8; ++o) fill[o] = offsets[o];
+    for (size_t k = begin; k < end; ++k) {
+        uint32_t i = s.order[k];
+        s.scratch[fill[octantOf(s.x[i], s.y[i], s.z[i], cx, cy, cz)]++] = i;
+    }
+    copy(s.scratch.begin() + begin, s.scratch.begin() + end, s.order.begin() + begin);
+}
+
+static NBodyNode makeNode(float cx, float cy, float cz, float half, size_t begin, size_t end) {
+    NBodyNode n;
+    n.cx = cx; n.cy = cy; n.cz = cz; n.half = half;
+    n.comX = n.comY = n.comZ = n.mass = 0.0f;
+    for (int c = 0; c < 8; ++c) n.child[c] = -1;
+    n.bodyBegin = (int)begin;
+    n.bodyCount = (int)(end - begin);
+    n.leaf = true;
+    return n;
+}
+
+static void childCube(const NBodyNode &n, int o, float &cx, float &cy, float &cz, float &half) {
+    half = n.half * 0.5f;
+    cx = n.cx + ((o & 1) ? half : -half);
+    cy = n.cy + ((o & 2) ? half : -half);
+    cz = n.cz + ((o & 4) ? half : -half);
+}
+
+static void accumulateMoments(NBodySystem &s, vector<NBodyNode> &pool, int idx) {
+    NBodyNode &n = pool[idx];
+    double m = 0.0, mx = 0.0, my = 0.0, mz = 0.0;
+    if (n.leaf) {
+        for (int k = n.bodyBegin; k < n.bodyBegin + n.bodyCount; ++k) {
+            uint32_t i = s.order[k];
+            m += s.mass[i]; mx += s.mass[i] * s.x[i]; my += s.mass[i] * s.y[i]; mz += s.mass[i] * s.z[i];
+        }
+    } else {
+        for (int c = 0; c < 8; ++c) {
+            if (n.child[c] < 0) continue;
+            const NBodyNode &ch = pool[n.child[c]];
+            m += ch.mass; mx += ch.mass * ch.comX; my += ch.mass * ch.comY; mz += ch.mass * ch.comZ;
+        }
+    }
+    n.mass = (float)m;
+    if (m > 0.0) { n.comX = float(mx / m); n.comY = float(my / m); n.comZ = float(mz / m); }
+    else { n.comX = n.cx; n.comY = n.cy; n.comZ = n.cz; }
+}
+
+// Recursive build into a private node pool; returns index of the subtree root in pool.
+static int buildSubtree(NBodySystem &s, vector<NBodyNode> &pool, size_t begin, size_t end,
+                        float cx, float cy, float cz, float half, int depth) {
+    int idx = (int)pool.size();
+    pool.push_back(makeNode(cx, cy, cz, half, begin, end));
+    if ((int)(end - begin) > s.params.leafCapacity && depth < 32) {
+        size_t off[9];
+        partitionOctants(s, begin, end, cx, cy, cz, off);
+        pool[idx].leaf = false;
+        for (int o = 0; o < 8; ++o) {
+            if (off[o + 1] == off[o]) continue;
+            float ccx, ccy, ccz, ch;
+            childCube(pool[idx], o, ccx, ccy, ccz, ch);
+            int c = buildSubtree(s, pool, off[o], off[o + 1], ccx, ccy, ccz, ch, depth + 1);
+            pool[idx].child[o] = c;
+        }
+    }
+    accumulateMoments(s, pool, idx);
+    return idx;
+}
+
+void nbodyBuildTree(NBodySystem &s) {
+    const size_t n = s.size();
+    const unsigned threads = resolveThreadCount(s.params.threads);
+    s.nodes.clear();
+    s.order.resize(n);
+    s.scratch.resize(n);
+    if (n == 0) return;
+    for (size_t i = 0; i < n; ++i) s.order[i] = (uint32_t)i;
+
+    // bounding cube (parallel min/max)
+    vector<float> bounds(threads * 6);
+    for (unsigned t = 0; t < threads; ++t)
+        for (int k = 0; k < 3; ++k) { bounds[t*6 + k] = INFINITY; bounds[t*6 + 3 + k] = -INFINITY; }
+    parallelFor(n, threads, [&](size_t b, size_t e, unsigned t) {
+        float lo[3] = { s.x[b], s.y[b], s.z[b] }, hi[3] = { s.x[b], s.y[b], s.z[b] };
+        for (size_t i = b; i < e; ++i) {
+            lo[0] = min(lo[0], s.x[i]); hi[0] = max(hi[0], s.x[i]);
+            lo[1] = min(lo[1], s.y[i]); hi[1] = max(hi[1], s.y[i]);
+            lo[2] = min(lo[2], s.z[i]); hi[2] = max(hi[2], s.z[i]);
+        }
+        for (int k = 0; k < 3; ++k) { bounds[t*6 + k] = lo[k]; bounds[t*6 + 3 + k] = hi[k]; }
+    });
+    float lo[3] = { bounds[0], bounds[1], bounds[2] }, hi[3] = { bounds[3], bounds[4], bounds[5] };
+    for (unsigned t = 1; t < threads; ++t)
+        for (int k = 0; k < 3; ++k) { lo[k] = min(lo[k], bounds[t*6 + k]); hi[k] = max(hi[k], bounds[t*6 + 3 + k]); }
+    float half = 0.5f * max(hi[0] - lo[0], max(hi[1] - lo[1], hi[2] - lo[2])) * 1.001f + 1e-6f;
+
+    // top levels serially until there is enough independent work
+    s.nodes.push_back(makeNode(0.5f*(lo[0]+hi[0]), 0.5f*(lo[1]+hi[1]), 0.5f*(lo[2]+hi[2]), half, 0, n));
+    struct Task { int parent; int octant; size_t begin, end; float cx, cy, cz, half; int depth; };
+    vector<Task> tasks;
+    vector<int> frontier(1, 0);
+    vector<int> topInternal;
+    const size_t wantTasks = size_t(threads) * 8;
+    int depth = 0;
+    while (!frontier.empty()) {
+        vector<int> next;
+        for (int idx : frontier) {
+            NBodyNode &nd = s.nodes[idx];
+            if (nd.bodyCount <= s.params.leafCapacity) continue; // stays a leaf
+            size_t off[9];
+            partitionOctants(s, nd.bodyBegin, nd.bodyBegin + nd.bodyCount, nd.cx, nd.cy, nd.cz, off);
+            s.nodes[idx].leaf = false;
+            topInternal.push_back(idx);
+            for (int o = 0; o < 8; ++o) {
+                if (off[o + 1] == off[o]) continue;
+                float ccx, ccy, ccz, ch;
+                childCube(s.nodes[idx], o, ccx, ccy, ccz, ch);
+                if (frontier.size() * 8 >= wantTasks || depth >= 3) {
+                    tasks.push_back({ idx, o, off[o], off[o + 1], ccx, ccy, ccz, ch, depth + 1 });
+                } else {
+                    int c = (int)s.nodes.size();
+                    s.nodes.push_back(makeNode(ccx, ccy, ccz, ch, off[o], off[o + 1]));
+                    s.nodes[idx].child[o] = c;
+                    next.push_back(c);
+                }
+            }
+        }
+        for (int idx : next) if (s.nodes[idx].bodyCount <= s.params.leafCapacity) accumulateMoments(s, s.nodes, idx);
+        frontier.swap(next);
+        ++depth;
+    }
+    if (s.nodes[0].leaf) accumulateMoments(s, s.nodes, 0);
+
+    // subtrees in parallel, each into its own pool (disjoint ranges of order/scratch)
+    vector<vector<NBodyNode>> pools(tasks.size());
+    parallelTasks(tasks.size(), threads, [&](size_t k, unsigned) {
+        const Task &t = tasks[k];
+        pools[k].reserve((t.end - t.begin) / 4 + 1);
+        buildSubtree(s, pools[k], t.begin, t.end, t.cx, t.cy, t.cz, t.half, t.depth);
+    });
+
+    // splice pools into the global array
+    for (size_t k = 0; k < tasks.size(); ++k) {
+        int base = (int)s.nodes.size();
+        for (NBodyNode nd : pools[k]) {
+            for (int c = 0; c < 8; ++c) if (nd.child[c] >= 0) nd.child[c] += base;
+            s.nodes.push_back(nd);
+        }
+        s.nodes[tasks[k].parent].child[tasks[k].octant] = base;
+    }
+    for (auto it = topInternal.rbegin(); it != topInternal.rend(); ++it) accumulateMoments(s, s.nodes, *it);
+
+    // gather bodies in tree order for the force walk
+    s.sx.resize(n); s.sy.resize(n); s.sz.resize(n); s.sm.resize(n);
+    parallelFor(n, threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t k = b; k < e; ++k) {
+            uint32_t i = s.order[k];
+            s.sx[k] = s.x[i]; s.sy[k] = s.y[i]; s.sz[k] = s.z[i]; s.sm[k] = s.mass[i];
+        }
+    });
+}
+
+// ========================================================
+// ================= Force / potential walk ===============
+// ========================================================
+//
+// Bodies of one group (the highest node holding <= groupSize bodies) share a single
+// tree walk: the opening test uses the distance from a node's center of mass to the
+// group's cube, which is conservative for every body in it. The walk produces one
+// flat SoA interaction list (accepted monopoles followed by the bodies of opened
+// leaves) that is then applied to each body of the group with a SIMD loop.
+
+struct InteractionList {
+    vector<float> mx, my, mz, mm;   // point sources: monopoles and leaf bodies
+    void clear() { mx.clear(); my.clear(); mz.clear(); mm.clear(); }
+    void push(float x, float y, float z, float m) { mx.push_back(x); my.push_back(y); mz.push_back(z); mm.push_back(m); }
+};
+
+static const int kGroupSize = 128;
+
+static void buildInteractionList(const NBodySystem &s, int groupIdx, InteractionList &list) {
+    const NBodyNode &L = s.nodes[groupIdx];
+    const float theta = s.params.theta;
+    list.clear();
+    int stack[256];
+    int sp = 0;
+    stack[sp++] = 0;
+    while (sp > 0) {
+        int idx = stack[--sp];
+        const NBodyNode &n = s.nodes[idx];
+        if (idx == groupIdx) continue; // handled separately (self exclusion)
+        // distance from the node's center of mass to the group cube
+        float dx = max(0.0f, fabs(n.comX - L.cx) - L.half);
+        float dy = max(0.0f, fabs(n.comY - L.cy) - L.half);
+        float dz = max(0.0f, fabs(n.comZ - L.cz) - L.half);
+        float d2 = dx*dx + dy*dy + dz*dz;
+        float size = 2.0f * n.half;
+        bool containsGroup = fabs(L.cx - n.cx) < n.half && fabs(L.cy - n.cy) < n.half && fabs(L.cz - n.cz) < n.half;
+        if (!containsGroup && size * size < theta * theta * d2) {
+            list.push(n.comX, n.comY, n.comZ, n.mass);
+        } else if (n.leaf) {
+            for (int q = n.bodyBegin; q < n.bodyBegin + n.bodyCount; ++q) list.push(s.sx[q], s.sy[q], s.sz[q], s.sm[q]);
+        } else {
+            for (int c = 0; c < 8; ++c) if (n.child[c] >= 0 && sp < 256) stack[sp++] = n.child[c];
+        }
+    }
+}
+
+// Softened point-mass sum of n sources (SoA) onto (px,py,pz), vfloat::width at a time.
+struct ForceAccum { float fx = 0.0f, fy = 0.0f, fz = 0.0f, phi = 0.0f; };
+
+static inline void accumulateSources(const float *qx, const float *qy, const float *qz, const float *qm, size_t n,
+                                     float px, float py, float pz, float eps2, ForceAccum &acc) {
+    const int W = vfloat::width;
+    size_t k = 0;
+    if (n >= (size_t)W) {
+        const vfloat vpx(px), vpy(py), vpz(pz), veps2(eps2), one(1.0f);
+        vfloat ax(0.0f), ay(0.0f), az(0.0f), pp(0.0f);
+        for (; k + W <= n; k += W) {
+            vfloat dx = vfloat::load(qx + k) - vpx, dy = vfloat::load(qy + k) - vpy, dz = vfloat::load(qz + k) - vpz;
+            vfloat inv = one / vsqrt(dx*dx + dy*dy + dz*dz + veps2);
+            vfloat mInv = vfloat::load(qm + k) * inv;
+            vfloat mInv3 = mInv * inv * inv;
+            ax += dx * mInv3; ay += dy * mInv3; az += dz * mInv3; pp -= mInv;
+        }
+        acc.fx += vhsum(ax); acc.fy += vhsum(ay); acc.fz += vhsum(az); acc.phi += vhsum(pp);
+    }
+    for (; k < n; ++k) {
+        float dx = qx[k] - px, dy = qy[k] - py, dz = qz[k] - pz;
+        float inv = 1.0f / sqrt(dx*dx + dy*dy + dz*dz + eps2);
+        float mInv = qm[k] * inv;
+        float mInv3 = mInv * inv * inv;
+        acc.fx += dx * mInv3; acc.fy += dy * mInv3; acc.fz += dz * mInv3; acc.phi -= mInv;
+    }
+}
+
+// Evaluates every body of the group; writes accelerations (by body index) and, if phiOut, potentials (tree order).
+static void evaluateGroup(NBodySystem &s, int groupIdx, InteractionList &list, float *phiOut) {
+    buildInteractionList(s, groupIdx, list);
+    const NBodyNode &L = s.nodes[groupIdx];
+    const float eps2 = max(s.params.softening * s.params.softening, 1e-12f);
+    const float G = s.params.G;
+    const float *qx = s.sx.data(), *qy = s.sy.data(), *qz = s.sz.data(), *qm = s.sm.data();
+    const int gb = L.bodyBegin, ge = L.bodyBegin + L.bodyCount;
+    for (int p = gb; p < ge; ++p) {
+        const float px = qx[p], py = qy[p], pz = qz[p];
+        ForceAccum acc;
+        accumulateSources(list.mx.data(), list.my.data(), list.mz.data(), list.mm.data(), list.mm.size(),
+                          px, py, pz, eps2, acc);
+        // own group without self-interaction
+        accumulateSources(qx + gb, qy + gb, qz + gb, qm + gb, size_t(p - gb), px, py, pz, eps2, acc);
+        accumulateSources(qx + p + 1, qy + p + 1, qz + p + 1, qm + p + 1, size_t(ge - p - 1), px, py, pz, eps2, acc);
+
+        uint32_t i = s.order[p];
+        s.ax[i] = G * acc.fx; s.ay[i] = G * acc.fy; s.az[i] = G * acc.fz;
+        if (phiOut) phiOut[p] = G * acc.phi;
+    }
+}
+
+static void evaluateAllGroups(NBodySystem &s, float *phiOut) {
+    vector<int> groups;
+    vector<int> stack(1, 0);
+    while (!stack.empty()) {
+        int idx = stack.back(); stack.pop_back();
+        const NBodyNode &n = s.nodes[idx];
+        if (n.leaf || n.bodyCount <= kGroupSize) { groups.push_back(idx); continue; }
+        for (int c = 0; c < 8; ++c) if (n.child[c] >= 0) stack.push_back(n.child[c]);
+    }
+    unsigned threads = resolveThreadCount(s.params.threads);
+    vector<InteractionList> lists(threads);
+    // a few groups per task keeps the shared counter cold
+    const size_t perTask = 4;
+    size_t taskCount = (groups.size() + perTask - 1) / perTask;
+    parallelTasks(taskCount, threads, [&](size_t t, unsigned ti) {
+        size_t b = t * perTask, e = min(groups.size(), b + perTask);
+        for (size_t k = b; k < e; ++k) evaluateGroup(s, groups[k], lists[ti], phiOut);
+    });
+}
+
+void nbodyComputeForces(NBodySystem &s) {
+    auto t0 = chrono::steady_clock::now();
+    nbodyBuildTree(s);
+    s.lastTimings.buildMs = elapsedMs(t0);
+
+    auto t1 = chrono::steady_clock::now();
+    evaluateAllGroups(s, nullptr);
+    s.lastTimings.forceMs = elapsedMs(t1);
+    s.accelValid = true;
+}
+
+void nbodyStep(NBodySystem &s, float dt) {
+    auto t0 = chrono::steady_clock::now();
+    if (!s.accelValid) nbodyComputeForces(s);
+    const float hdt = 0.5f * dt;
+    // kick + drift
+    parallelFor(s.size(), s.params.threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t i = b; i < e; ++i) {
+            s.vx[i] += s.ax[i] * hdt; s.vy[i] += s.ay[i] * hdt; s.vz[i] += s.az[i] * hdt;
+            s.x[i] += s.vx[i] * dt;   s.y[i] += s.vy[i] * dt;   s.z[i] += s.vz[i] * dt;
+        }
+    });
+    nbodyComputeForces(s);
+    // kick
+    parallelFor(s.size(), s.params.threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t i = b; i < e; ++i) {
+            s.vx[i] += s.ax[i] * hdt; s.vy[i] += s.ay[i] * hdt; s.vz[i] += s.az[i] * hdt;
+        }
+    });
+    s.lastTimings.stepMs = elapsedMs(t0);
+}
+
+double nbodyTotalEnergy(NBodySystem &s) {
+    // recomputes accelerations for the current positions as a side effect
+    nbodyBuildTree(s);
+    vector<float> phi(s.size(), 0.0f);
+    evaluateAllGroups(s, phi.data());
+    s.accelValid = true;
+    double total = 0.0;
+    for (size_t p = 0; p < s.size(); ++p) {
+        uint32_t i = s.order[p];
+        double v2 = double(s.vx[i])*s.vx[i] + double(s.vy[i])*s.vy[i] + double(s.vz[i])*s.vz[i];
+        total += 0.5 * s.mass[i] * v2 + 0.5 * double(s.mass[i]) * phi[p];
+    }
+    return total;
+}
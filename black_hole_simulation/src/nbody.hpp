@@ -0,0 +1,67 @@
+// nbody.hpp
+// Gravitational N-body integrator for the stars orbiting the hole.
+//  - structure-of-arrays body storage (x[], y[], z[], ...)
+//  - Barnes-Hut octree rebuilt every step; the top levels are split serially,
+//    the subtrees below are built in parallel
+//  - symplectic leapfrog (kick-drift-kick)
+// Units are scene units with G = 1 by default. No GL dependency.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct NBodyParams {
+    float G = 1.0f;
+    float theta = 0.6f;       // opening angle (node size / distance)
+    float softening = 0.01f;  // Plummer softening length
+    int leafCapacity = 16;    // max bodies per octree leaf
+    unsigned threads = 0;     // 0 -> hardware_concurrency
+};
+
+struct NBodyNode {
+    float cx, cy, cz, half;          // cube center and half size
+    float comX, comY, comZ, mass;    // monopole
+    int child[8];                    // -1 if empty
+    int bodyBegin, bodyCount;        // range in tree order (whole subtree)
+    bool leaf;
+};
+
+struct NBodyTimings {
+    double buildMs = 0.0;
+    double forceMs = 0.0;
+    double stepMs = 0.0;
+};
+
+struct NBodySystem {
+    // body state (SoA)
+    std::vector<float> x, y, z;
+    std::vector<float> vx, vy, vz;
+    std::vector<float> ax, ay, az;
+    std::vector<float> mass;
+
+    NBodyParams params;
+    bool accelValid = false;
+
+    // octree, rebuilt each step
+    std::vector<NBodyNode> nodes;
+    std::vector<uint32_t> order;               // tree order -> body index
+    std::vector<float> sx, sy, sz, sm;         // positions/masses gathered in tree order
+    std::vector<uint32_t> scratch;
+
+    NBodyTimings lastTimings;
+
+    size_t size() const { return x.size(); }
+    void resize(size_t n);
+};
+
+// Central mass at the origin (body 0) plus n-1 stars on near-circular orbits in a
+// thick disk between rInner and rOuter. Deterministic for a given seed.
+void nbodyInitOrbitingDisk(NBodySystem &s, size_t n, float centralMass, float starMass,
+                           float rInner, float rOuter, float thickness, uint32_t seed);
+
+void nbodyBuildTree(NBodySystem &s);
+void nbodyComputeForces(NBodySystem &s);      // rebuilds the tree
+void nbodyStep(NBodySystem &s, float dt);     // one leapfrog KDK step
+double nbodyTotalEnergy(NBodySystem &s);      // kinetic + tree potential
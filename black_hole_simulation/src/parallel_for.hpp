@@ -0,0 +1,54 @@
+// parallel_for.hpp
+// Tiny fork/join helpers on top of std::thread (no external dependency).
+//  - parallelFor: splits [0, n) in contiguous chunks, one thread per chunk
+//  - parallelTasks: threads pull task indices from a shared counter (uneven work)
+// threads == 0 means "use hardware_concurrency".
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+inline unsigned resolveThreadCount(unsigned threads) {
+    if (threads > 0) return threads;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// fn(begin, end, chunkIndex)
+template <class F>
+void parallelFor(size_t n, unsigned threads, F &&fn, size_t minChunk = 1024) {
+    unsigned t = resolveThreadCount(threads);
+    size_t maxChunks = (n + minChunk - 1) / minChunk;
+    if (maxChunks < t) t = (unsigned)std::max<size_t>(1, maxChunks);
+    if (t <= 1) { fn(size_t(0), n, 0u); return; }
+
+    std::vector<std::thread> pool;
+    pool.reserve(t - 1);
+    size_t chunk = (n + t - 1) / t;
+    for (unsigned k = 1; k < t; ++k) {
+        size_t b = std::min(n, k * chunk), e = std::min(n, b + chunk);
+        pool.emplace_back([&fn, b, e, k]() { fn(b, e, k); });
+    }
+    fn(size_t(0), std::min(n, chunk), 0u);
+    for (auto &th : pool) th.join();
+}
+
+// fn(taskIndex, threadIndex)
+template <class F>
+void parallelTasks(size_t taskCount, unsigned threads, F &&fn) {
+    unsigned t = (unsigned)std::min<size_t>(resolveThreadCount(threads), std::max<size_t>(1, taskCount));
+    std::atomic<size_t> next(0);
+    auto worker = [&](unsigned ti) {
+        for (size_t k = next.fetch_add(1); k < taskCount; k = next.fetch_add(1)) fn(k, ti);
+    };
+    if (t <= 1) { worker(0); return; }
+    std::vector<std::thread> pool;
+    pool.reserve(t - 1);
+    for (unsigned k = 1; k < t; ++k) pool.emplace_back(worker, k);
+    worker(0);
+    for (auto &th : pool) th.join();
+}
@@ -0,0 +1,176 @@
+// photon_ring.cpp
+// Kerr critical curve and photon subrings, see photon_ring.hpp.
+
+#include "photon_ring.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace std;
+
+namespace {
+
+struct CurvePoint { double alpha, beta, gamma; };
+
+// Spherical photon orbit radii (prograde, retrograde) for spin a, M = 1
+void photonOrbitRange(double a, double &rMin, double &rMax) {
+    rMin = 2.0 * (1.0 + cos(2.0 / 3.0 * acos(-a)));
+    rMax = 2.0 * (1.0 + cos(2.0 / 3.0 * acos(a)));
+}
+
+void conserved(double a, double r, double &xi, double &eta) {
+    xi = (r*r * (3.0 - r) - a*a * (r + 1.0)) / (a * (r - 1.0));
+    eta = r*r*r * (4.0*a*a - r * (r - 3.0) * (r - 3.0)) / (a*a * (r - 1.0) * (r - 1.0));
+}
+
+double betaSquared(double a, double r, double theta) {
+    double xi, eta;
+    conserved(a, r, xi, eta);
+    double c = cos(theta), s = sin(theta);
+    return eta + a*a * c*c - xi*xi * (c*c) / (s*s);
+}
+
+// Complete elliptic integral of the first kind K(m) for parameter m < 1 (including m < 0)
+double ellipticK(double m) {
+    if (m < 0.0) return ellipticK(m / (m - 1.0)) / sqrt(1.0 - m);
+    // arithmetic-geometric mean
+    double x = 1.0, y = sqrt(1.0 - m);
+    for (int i = 0; i < 32 && fabs(x - y) > 1e-15 * x; ++i) {
+        double nx = 0.5 * (x + y);
+        y = sqrt(x * y);
+        x = nx;
+    }
+    return M_PI / (2.0 * x);
+}
+
+// Lyapunov exponent of the spherical photon orbit at r (Johnson et al. 2020)
+double lyapunovExponent(double a, double r) {
+    double xi, eta;
+    conserved(a, r, xi, eta);
+    double delta = r*r - 2.0*r + a*a;
+    double chi = 1.0 - delta / (r * (r - 1.0) * (r - 1.0));
+    double dTheta = 0.5 * (1.0 - (eta + xi*xi) / (a*a));
+    double root = sqrt(dTheta*dTheta + eta / (a*a));
+    double uPlus = dTheta + root, uMinus = dTheta - root;
+    if (uMinus >= 0.0 || chi <= 0.0) return M_PI;
+    return 4.0 * r * sqrt(chi) / sqrt(-uMinus * a*a) * ellipticK(uPlus / uMinus);
+}
+
+} // namespace
+
+void computePhotonRingCurve(PhotonRingCurve &out, float spin, float inclination, int points) {
+    out = PhotonRingCurve();
+    out.spin = spin;
+    out.inclination = inclination;
+    points = max(points, 8);
+
+    const double a = min(fabs((double)spin), 0.999);
+    // keep away from the poles, where alpha/beta are singular (the curve is a circle there anyway)
+    const double theta = min(max((double)inclination, 0.02), M_PI - 0.02);
+
+    vector<CurvePoint> loop;
+    if (a < 1e-3) {
+        const double b = 3.0 * sqrt(3.0);
+        for (int i = 0; i < points; ++i) {
+            double t = 2.0 * M_PI * i / points;
+            loop.push_back({ b * cos(t), b * sin(t), M_PI });
+        }
+    } else {
+        double rMin, rMax;
+        photonOrbitRange(a, rMin, rMax);
+        // the visible part of [rMin, rMax] is where beta^2 >= 0; find its ends
+        const int scan = 2048;
+        double lo = -1.0, hi = -1.0;
+        for (int i = 0; i <= scan; ++i) {
+            double r = rMin + (rMax - rMin) * i / scan;
+            if (betaSquared(a, r, theta) >= 0.0) { if (lo < 0.0) lo = r; hi = r; }
+        }
+        if (lo < 0.0) { lo = hi = 3.0; }
+        auto refine = [&](double inside, double outside) {
+            for (int k = 0; k < 60; ++k) {
+                double mid = 0.5 * (inside + outside);
+                if (betaSquared(a, mid, theta) >= 0.0) inside = mid; else outside = mid;
+            }
+            return inside;
+        };
+        double step = (rMax - rMin) / scan;
+        if (lo - step >= rMin) lo = refine(lo, lo - step);
+        if (hi + step <= rMax) hi = refine(hi, hi + step);
+
+        // dense upper branch (cosine spacing bunches samples at the turning points)
+        const int dense = 4 * points;
+        vector<CurvePoint> upper;
+        for (int i = 0; i <= dense; ++i) {
+            double u = 0.5 - 0.5 * cos(M_PI * i / dense);
+            double r = lo + (hi - lo) * u;
+            double xi, eta;
+            conserved(a, r, xi, eta);
+            double b2 = max(betaSquared(a, r, theta), 0.0);
+            upper.push_back({ -xi / sin(theta), sqrt(b2), lyapunovExponent(a, r) });
+        }
+        loop = upper;
+        for (int i = dense - 1; i >= 1; --i) loop.push_back({ upper[i].alpha, -upper[i].beta, upper[i].gamma });
+    }
+
+    // resample uniformly in arc length
+    const size_t m = loop.size();
+    vector<double> arc(m + 1, 0.0);
+    for (size_t i = 0; i < m; ++i) {
+        const CurvePoint &p = loop[i], &q = loop[(i + 1) % m];
+        arc[i + 1] = arc[i] + hypot(q.alpha - p.alpha, q.beta - p.beta);
+    }
+    double total = arc[m];
+    size_t seg = 0;
+    double cx = 0.0, cy = 0.0;
+    for (int k = 0; k < points; ++k) {
+        double s = total * k / points;
+        while (seg + 1 < m && arc[seg + 1] < s) ++seg;
+        const CurvePoint &p = loop[seg], &q = loop[(seg + 1) % m];
+        double len = arc[seg + 1] - arc[seg];
+        double t = len > 0.0 ? (s - arc[seg]) / len : 0.0;
+        out.alpha.push_back(float(p.alpha + (q.alpha - p.alpha) * t));
+        out.beta.push_back(float(p.beta + (q.beta - p.beta) * t));
+        out.lyapunov.push_back(float(p.gamma + (q.gamma - p.gamma) * t));
+        cx += out.alpha.back(); cy += out.beta.back();
+    }
+    cx /= points; cy /= points;
+
+    // outward normals from the loop tangent
+    double radiusSum = 0.0;
+    out.nx.resize(points); out.ny.resize(points);
+    for (int k = 0; k < points; ++k) {
+        int prev = (k + points - 1) % points, next = (k + 1) % points;
+        double tx = out.alpha[next] - out.alpha[prev], ty = out.beta[next] - out.beta[prev];
+        double nx = ty, ny = -tx;
+        double len = hypot(nx, ny);
+        if (len <= 0.0) { nx = out.alpha[k] - cx; ny = out.beta[k] - cy; len = hypot(nx, ny); }
+        nx /= len; ny /= len;
+        if (nx * (out.alpha[k] - cx) + ny * (out.beta[k] - cy) < 0.0) { nx = -nx; ny = -ny; }
+        out.nx[k] = float(nx); out.ny[k] = float(ny);
+        radiusSum += hypot(out.alpha[k], out.beta[k]);
+    }
+    out.meanRadius = float(radiusSum / points);
+}
+
+vector<PhotonSubring> photonSubrings(int maxOrder) {
+    vector<PhotonSubring> rings;
+    for (int n = 1; n <= maxOrder; ++n) rings.push_back({ float(n), 0.12f, 0.04f, 1.0f });
+    return rings;
+}
+
+const PhotonRingCurve& photonRingCached(PhotonRingCache &cache, float spin, float inclination, uint32_t *key) {
+    int spinKey = (int)lround(min(fabs(spin), 0.999f) * 100.0f);
+    int inclKey = (int)lround(min(max(inclination, 0.0f), float(M_PI)) * 180.0f / float(M_PI));
+    uint32_t k = (uint32_t(spinKey) << 16) | uint32_t(inclKey);
+    if (key) *key = k;
+    auto it = cache.curves.find(k);
+    if (it == cache.curves.end()) {
+        it = cache.curves.emplace(k, PhotonRingCurve()).first;
+        computePhotonRingCurve(it->second, spinKey / 100.0f, inclKey * float(M_PI) / 180.0f, cache.points);
+    }
+    return it->second;
+}
@@ -0,0 +1,48 @@
+// photon_ring.hpp
+// Critical curve of a Kerr black hole as seen by a distant observer, and the
+// n = 1, 2, ... photon subrings that hug it. No GL dependency.
+//
+// Units of M (G = c = 1). For Schwarzschild the curve is the circle b = 3*sqrt(3) M;
+// for spin a > 0 it is traced from the spherical photon orbits (Bardeen 1973):
+//     xi(r)  = (r^2 (3 - r) - a^2 (r + 1)) / (a (r - 1))
+//     eta(r) = r^3 (4 a^2 - r (r - 3)^2) / (a^2 (r - 1)^2)
+//     alpha  = -xi / sin(theta_o),  beta = +-sqrt(eta + a^2 cos^2(theta_o) - xi^2 cot^2(theta_o))
+// Each point also carries the Lyapunov exponent gamma of its orbit: subring n sits
+// ~e^(-gamma n) outside the curve and is e^(-gamma n) as wide (gamma = pi for a = 0).
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+struct PhotonRingCurve {
+    float spin = 0.0f;
+    float inclination = 0.0f;       // observer angle from the spin axis (radians)
+    float meanRadius = 0.0f;        // average |(alpha, beta)|
+    // closed loop, uniformly spaced in arc length (the last point is not repeated)
+    std::vector<float> alpha, beta;
+    std::vector<float> nx, ny;      // outward normals
+    std::vector<float> lyapunov;    // gamma per point
+};
+
+// Describes one subring instance for drawing (see shaders in black_hole.cpp).
+struct PhotonSubring {
+    float n;             // subring order (1, 2, ...)
+    float offsetScale;   // radial offset = offsetScale * b * e^(-gamma n)
+    float widthScale;    // half width    = widthScale  * b * e^(-gamma n)
+    float brightness;    // surface brightness; the flux of order n falls with its width
+};
+
+void computePhotonRingCurve(PhotonRingCurve &out, float spin, float inclination, int points);
+
+// Default n = 1..maxOrder subring set
+std::vector<PhotonSubring> photonSubrings(int maxOrder);
+
+// Curves cached by quantized (spin, inclination): 0.01 in spin, 1 degree in inclination.
+struct PhotonRingCache {
+    int points = 256;
+    std::map<uint32_t, PhotonRingCurve> curves;
+};
+// Returns the cached curve; `key` receives the cache key (handy to detect changes).
+const PhotonRingCurve& photonRingCached(PhotonRingCache &cache, float spin, float inclination, uint32_t *key = nullptr);
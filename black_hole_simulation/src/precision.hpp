@@ -0,0 +1,28 @@
+// precision.hpp
+// Compile-time precision policies for the templated physics kernels
+// (geodesic.hpp). Compute is the type forces / accelerations are evaluated
+// in, Accum the type the integrated state (positions, velocities) is kept and summed in.
+//  - FloatPrecision : float everywhere, what the real-time SIMD kernels use
+//  - DoublePrecision: double everywhere, the reference
+//  - MixedPrecision : float forces, double accumulation: small per-step increments
+//    are not lost against large coordinates
+
+#pragma once
+
+struct FloatPrecision {
+    using Compute = float;
+    using Accum = float;
+    static const char *name() { return "float"; }
+};
+
+struct DoublePrecision {
+    using Compute = double;
+    using Accum = double;
+    static const char *name() { return "double"; }
+};
+
+struct MixedPrecision {
+    using Compute = float;
+    using Accum = double;
+    static const char *name() { return "mixed"; }
+};
@@ -0,0 +1,218 @@
+// precision_bench.cpp
+// Accuracy versus speed of the geodesic integrator in each precision mode (no window,
+// no GL). Every mode runs the one kernel of geodesic.cpp on the same photons and the
+// same bound orbits:
+//   float  - GeodesicBatch (FloatPrecision), what the renderer runs, on vfloat
+//   mixed  - GeodesicBatchT<MixedPrecision>: float forces, double state, scalar
+//   double - GeodesicBatchT<DoublePrecision>, on vdouble
+// Rounding error is measured against double at the same step, truncation error as
+// double at the same step against double at dλ / 8.
+//
+//   precision_bench [--rays N] [--orbits N] [--steps N] [--threads T]
+//
+// Photons start at x = -200M heading +x with impact parameters from just above the
+// critical 3√3 M out to 50M, and run until they are ~200M past the hole; the error
+// reported is in the deflection angle and the end position. Orbits are as in
+// geodesic_bench (6.5M..30M, mildly eccentric) and report E / L drift.
+
+#include "geodesic.hpp"
+#include "parallel_for.hpp"
+#include "simd.hpp"
+#include "units.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+const double kRayStart = -200.0;
+const double kRayStep = 0.05;
+const double kOrbitStep = 0.02;
+
+double rayImpact(size_t i, size_t n) {
+    // denser near the photon sphere, where the deflection is most sensitive
+    double u = (i + 0.5) / double(n);
+    return 3.0 * std::sqrt(3.0) * 1.02 + (50.0 - 3.0 * std::sqrt(3.0) * 1.02) * u * u;
+}
+
+void orbitParams(size_t i, size_t n, float &r, float &incl, float &phase, float &speed) {
+    float u = (i + 0.5f) / float(n);
+    r = 6.5f + 23.5f * u;
+    incl = 0.6f * sinf(12.9898f * i);
+    phase = 6.2831853f * fmodf(i * 0.618034f, 1.0f);
+    speed = 0.97f + 0.03f * cosf(78.233f * i);
+}
+
+// End state of every particle of a run, in double
+struct RunResult {
+    const char *name = "";
+    double seconds = 0.0;
+    double particleSteps = 0.0;
+    std::vector<double> x, y, z, vx, vy, vz;
+    std::vector<unsigned char> alive;
+    GeodesicDrift drift;
+};
+
+template <class S>
+void collect(const S &s, RunResult &out) {
+    out.x.assign(s.x.begin(), s.x.begin() + s.count);
+    out.y.assign(s.y.begin(), s.y.begin() + s.count);
+    out.z.assign(s.z.begin(), s.z.begin() + s.count);
+    out.vx.assign(s.vx.begin(), s.vx.begin() + s.count);
+    out.vy.assign(s.vy.begin(), s.vy.begin() + s.count);
+    out.vz.assign(s.vz.begin(), s.vz.begin() + s.count);
+    out.alive.resize(s.count);
+    for (size_t i = 0; i < s.count; ++i) out.alive[i] = s.alive[i] != 0;
+    out.drift = geodesicMeasureDrift(s);
+}
+
+template <class S, class Step>
+void timeSteps(S &s, int steps, RunResult &out, Step step) {
+    auto t0 = std::chrono::steady_clock::now();
+    step(s, steps);
+    out.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    out.particleSteps = double(s.count) * steps;
+    collect(s, out);
+}
+
+template <class P>
+RunResult runRays(size_t n, int steps, double dl, unsigned threads) {
+    using Real = typename P::Accum;
+    GeodesicBatchT<P> s;
+    s.kind = GeodesicKind::Null;
+    for (size_t i = 0; i < n; ++i) {
+        Real p[3] = {Real(kRayStart), Real(rayImpact(i, n)), Real(0)};
+        Real d[3] = {Real(1), Real(0), Real(0)};
+        geodesicAddRay(s, p, d);
+    }
+    RunResult r;
+    r.name = P::name();
+    timeSteps(s, steps, r, [&](GeodesicBatchT<P> &g, int k) { geodesicStep(g, dl, k, threads); });
+    return r;
+}
+
+template <class P>
+RunResult runOrbits(size_t n, int steps, unsigned threads) {
+    GeodesicBatchT<P> s;
+    for (size_t i = 0; i < n; ++i) {
+        float r, incl, phase, speed;
+        orbitParams(i, n, r, incl, phase, speed);
+        geodesicAddOrbit(s, r, incl, phase, speed);
+    }
+    RunResult r;
+    r.name = P::name();
+    timeSteps(s, steps, r, [&](GeodesicBatchT<P> &g, int k) { geodesicStep(g, kOrbitStep, k, threads); });
+    return r;
+}
+
+struct Error {
+    double maxAngle = 0.0, meanAngle = 0.0;  // deflection, radians
+    double maxPos = 0.0, meanPos = 0.0;      // end position, units of M
+    size_t fateMismatch = 0;                 // captured in one run, escaped in the other
+};
+
+Error compare(const RunResult &a, const RunResult &ref) {
+    Error e;
+    size_t n = 0;
+    for (size_t i = 0; i < ref.x.size(); ++i) {
+        if (a.alive[i] != ref.alive[i]) { ++e.fateMismatch; continue; }
+        if (!ref.alive[i]) continue;
+        double da = std::fabs(std::atan2(a.vy[i], a.vx[i]) - std::atan2(ref.vy[i], ref.vx[i]));
+        double dx = a.x[i] - ref.x[i], dy = a.y[i] - ref.y[i], dz = a.z[i] - ref.z[i];
+        double dp = std::sqrt(dx*dx + dy*dy + dz*dz);
+        e.maxAngle = std::max(e.maxAngle, da);
+        e.maxPos = std::max(e.maxPos, dp);
+        e.meanAngle += da;
+        e.meanPos += dp;
+        ++n;
+    }
+    if (n > 0) { e.meanAngle /= n; e.meanPos /= n; }
+    return e;
+}
+
+void printUnits() {
+    // Kretschmann scalar 48 G^2 M^2 / (c^4 r^6) at r = 3 Rs of Sgr A*
+    const double M = units::sagittariusAMass;
+    const units::GeometrizedScale sc = units::geometrizedScale(M);
+    const double rM = 6.0;
+    float Gf = float(units::G), cf = float(units::c), Mf = float(M), rf = float(sc.toMeters(rM));
+    float siFloat = 48.0f * Gf * Gf * Mf * Mf / (cf * cf * cf * cf * rf * rf * rf * rf * rf * rf);
+    float geoFloat = 48.0f / std::pow(float(rM), 6.0f);
+    double siDouble = 48.0 * units::G * units::G * M * M / std::pow(units::c, 4) / std::pow(sc.toMeters(rM), 6);
+    printf("units: Sgr A* M = %.3e kg -> 1 M = %.4e m = %.4e s\n", M, sc.meters, sc.seconds);
+    printf("  Kretschmann at r = 6M: SI float %g m^-4 (G^2 M^2 = %g in float), geometrized float %g M^-4"
+           " = %.6e m^-4, SI double %.6e m^-4\n",
+           siFloat, Gf * Gf * Mf * Mf, geoFloat, double(geoFloat) / std::pow(sc.meters, 4), siDouble);
+}
+
+void printSpeed(const RunResult &r, const RunResult &ref) {
+    printf("  %-7s %10.2f M steps/s  (%.2fx double)\n", r.name, r.particleSteps / r.seconds * 1e-6,
+           ref.seconds / r.seconds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t rays = 256, orbits = 4096;
+    int orbitSteps = 20000;
+    unsigned threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--rays") == 0 && hasValue) rays = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--orbits") == 0 && hasValue) orbits = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--steps") == 0 && hasValue) orbitSteps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) threads = unsigned(atoi(argv[++i]));
+        else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (rays < 1 || orbits < 1 || orbitSteps < 1) {
+        fprintf(stderr, "bad --rays / --orbits / --steps\n");
+        return 2;
+    }
+
+    printUnits();
+    printf("simd width float=%d double=%d threads=%u\n", vfloat::width, vdouble::width, resolveThreadCount(threads));
+
+    // photons: 400M of travel plus room for the near-critical ones to wind around
+    const int raySteps = int(2.0 * -kRayStart / kRayStep) + 2000;
+    RunResult rf = runRays<FloatPrecision>(rays, raySteps, kRayStep, threads);
+    RunResult rm = runRays<MixedPrecision>(rays, raySteps, kRayStep, threads);
+    RunResult rd = runRays<DoublePrecision>(rays, raySteps, kRayStep, threads);
+    RunResult fine = runRays<DoublePrecision>(rays, raySteps * 8, kRayStep / 8.0, threads);
+
+    printf("\nrays: %zu photons, %d steps of dλ=%.3f, impact %.3fM..%.1fM\n", rays, raySteps, kRayStep,
+           rayImpact(0, rays), rayImpact(rays - 1, rays));
+    printf("  %-7s %14s %14s %14s %14s %8s\n", "mode", "max|dangle|", "mean|dangle|", "max|dpos| M",
+           "mean|dpos| M", "fate");
+    for (const RunResult *r : {&rf, &rm, &rd}) {
+        Error e = compare(*r, rd);
+        printf("  %-7s %14.3e %14.3e %14.3e %14.3e %8zu\n", r->name, e.maxAngle, e.meanAngle, e.maxPos,
+               e.meanPos, e.fateMismatch);
+    }
+    Error trunc = compare(rd, fine);
+    printf("  %-7s %14.3e %14.3e %14.3e %14.3e %8zu   (double vs dλ/8: truncation)\n", "step", trunc.maxAngle,
+           trunc.meanAngle, trunc.maxPos, trunc.meanPos, trunc.fateMismatch);
+    for (const RunResult *r : {&rf, &rm, &rd}) printSpeed(*r, rd);
+
+    RunResult of = runOrbits<FloatPrecision>(orbits, orbitSteps, threads);
+    RunResult om = runOrbits<MixedPrecision>(orbits, orbitSteps, threads);
+    RunResult od = runOrbits<DoublePrecision>(orbits, orbitSteps, threads);
+
+    printf("\norbits: %zu particles, %d steps of dτ=%.3f (6.5M..30M)\n", orbits, orbitSteps, kOrbitStep);
+    printf("  %-7s %12s %12s %12s %8s %14s\n", "mode", "max|dE/E|", "mean|dE/E|", "max|dL/L|", "alive",
+           "max|dpos| M");
+    for (const RunResult *r : {&of, &om, &od}) {
+        Error e = compare(*r, od);
+        printf("  %-7s %12.3e %12.3e %12.3e %8zu %14.3e\n", r->name, r->drift.maxRelE, r->drift.meanRelE,
+               r->drift.maxRelL, r->drift.alive, e.maxPos);
+    }
+    for (const RunResult *r : {&of, &om, &od}) printSpeed(*r, od);
+    return 0;
+}
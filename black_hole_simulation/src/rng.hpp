@@ -0,0 +1,31 @@
+// rng.hpp
+// Counter-based random numbers: value = hash(seed, stream, index), no hidden state.
+// The n-th number of a stream is the same whatever order (or thread) asks for it,
+// so generators can be split across threads and stay bit-identical to a serial run.
+// The mixer is the SplitMix64 finalizer (Stafford "Mix13"), which passes BigCrush
+// when fed a counter.
+
+#pragma once
+
+#include <cstdint>
+
+inline uint64_t rngMix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+struct CounterRng {
+    uint64_t key;
+
+    explicit CounterRng(uint64_t seed, uint64_t stream = 0)
+        : key(rngMix64(seed ^ rngMix64(stream + 0x9e3779b97f4a7c15ull))) {}
+
+    uint32_t bits(uint64_t index) const {
+        return uint32_t(rngMix64(key + index * 0x9e3779b97f4a7c15ull) >> 32);
+    }
+    // [0, 1) with 24 random bits
+    float uniform(uint64_t index) const { return (bits(index) >> 8) * (1.0f / 16777216.0f); }
+    // [-0.5, 0.5)
+    float centered(uint64_t index) const { return uniform(index) - 0.5f; }
+};
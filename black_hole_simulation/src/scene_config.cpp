@@ -0,0 +1,148 @@
+// scene_config.cpp
+// Scene parameter binding and loader, see scene_config.hpp.
+
+#include "scene_config.hpp"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+static void bindParam(SceneConfig &c, const char *name, SceneParamKind kind, void *ptr, unsigned dirty) {
+    auto it = c.index.find(name);
+    if (it != c.index.end()) { c.params[it->second] = { name, kind, ptr, dirty }; return; }
+    c.index.emplace(name, c.params.size());
+    c.params.push_back({ name, kind, ptr, dirty });
+}
+
+void sceneBind(SceneConfig &c, const char *name, int &v, unsigned dirty)      { bindParam(c, name, SceneParamKind::Int, &v, dirty); }
+void sceneBind(SceneConfig &c, const char *name, float &v, unsigned dirty)    { bindParam(c, name, SceneParamKind::Float, &v, dirty); }
+void sceneBind(SceneConfig &c, const char *name, double &v, unsigned dirty)   { bindParam(c, name, SceneParamKind::Double, &v, dirty); }
+void sceneBind(SceneConfig &c, const char *name, bool &v, unsigned dirty)     { bindParam(c, name, SceneParamKind::Bool, &v, dirty); }
+void sceneBind(SceneConfig &c, const char *name, uint64_t &v, unsigned dirty) { bindParam(c, name, SceneParamKind::U64, &v, dirty); }
+void sceneBind(SceneConfig &c, const char *name, string &v, unsigned dirty)   { bindParam(c, name, SceneParamKind::String, &v, dirty); }
+
+static bool isBlank(char ch) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n'; }
+
+static string trim(const char *b, const char *e) {
+    while (b < e && isBlank(*b)) ++b;
+    while (e > b && isBlank(e[-1])) --e;
+    return string(b, e);
+}
+
+// strtoX must consume the whole (trimmed) string
+static bool fullyParsed(const char *s, const char *end) { return end != s && *end == '\0' && errno == 0; }
+
+bool sceneSet(SceneConfig &c, const string &key, const string &value, unsigned &dirty, string &error) {
+    auto it = c.index.find(key);
+    if (it == c.index.end()) { error = "unknown parameter '" + key + "'"; return false; }
+    const SceneParam &p = c.params[it->second];
+    const char *s = value.c_str();
+    char *end = nullptr;
+    errno = 0;
+    bool changed = false;
+    switch (p.kind) {
+    case SceneParamKind::Int: {
+        long v = strtol(s, &end, 10);
+        if (!fullyParsed(s, end) || v < INT32_MIN || v > INT32_MAX) { error = "'" + key + "' expects an integer, got '" + value + "'"; return false; }
+        int &dst = *static_cast<int*>(p.ptr);
+        changed = dst != int(v); dst = int(v);
+        break;
+    }
+    case SceneParamKind::Float: {
+        float v = strtof(s, &end);
+        if (!fullyParsed(s, end)) { error = "'" + key + "' expects a number, got '" + value + "'"; return false; }
+        float &dst = *static_cast<float*>(p.ptr);
+        changed = dst != v; dst = v;
+        break;
+    }
+    case SceneParamKind::Double: {
+        double v = strtod(s, &end);
+        if (!fullyParsed(s, end)) { error = "'" + key + "' expects a number, got '" + value + "'"; return false; }
+        double &dst = *static_cast<double*>(p.ptr);
+        changed = dst != v; dst = v;
+        break;
+    }
+    case SceneParamKind::U64: {
+        unsigned long long v = strtoull(s, &end, 0);   // accepts 0x...
+        if (!fullyParsed(s, end) || value[0] == '-') { error = "'" + key + "' expects an unsigned integer, got '" + value + "'"; return false; }
+        uint64_t &dst = *static_cast<uint64_t*>(p.ptr);
+        changed = dst != uint64_t(v); dst = uint64_t(v);
+        break;
+    }
+    case SceneParamKind::Bool: {
+        bool v;
+        if (value == "1" || value == "true" || value == "on" || value == "yes") v = true;
+        else if (value == "0" || value == "false" || value == "off" || value == "no") v = false;
+        else { error = "'" + key + "' expects true/false, got '" + value + "'"; return false; }
+        bool &dst = *static_cast<bool*>(p.ptr);
+        changed = dst != v; dst = v;
+        break;
+    }
+    case SceneParamKind::String: {
+        string &dst = *static_cast<string*>(p.ptr);
+        changed = dst != value; dst = value;
+        break;
+    }
+    }
+    if (changed) dirty |= p.dirty;
+    return true;
+}
+
+bool sceneSetAssignment(SceneConfig &c, const string &assignment, unsigned &dirty, string &error) {
+    size_t eq = assignment.find('=');
+    if (eq == string::npos) { error = "expected KEY=VALUE, got '" + assignment + "'"; return false; }
+    const char *s = assignment.c_str();
+    return sceneSet(c, trim(s, s + eq), trim(s + eq + 1, s + assignment.size()), dirty, error);
+}
+
+bool sceneLoadFile(SceneConfig &c, const string &path, unsigned &dirty, string &error) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) { error = path + ": cannot open"; return false; }
+    string text;
+    char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) text.append(buf, n);
+    fclose(f);
+
+    error.clear();
+    int lineNo = 0;
+    const char *p = text.c_str(), *end = p + text.size();
+    while (p < end) {
+        const char *eol = static_cast<const char*>(memchr(p, '\n', size_t(end - p)));
+        if (!eol) eol = end;
+        ++lineNo;
+        const char *hash = static_cast<const char*>(memchr(p, '#', size_t(eol - p)));
+        string line = trim(p, hash ? hash : eol);
+        p = eol + 1;
+        if (line.empty()) continue;
+        string lineError;
+        if (!sceneSetAssignment(c, line, dirty, lineError)) {
+            if (!error.empty()) error += '\n';
+            error += path + ":" + to_string(lineNo) + ": " + lineError;
+        }
+    }
+    return error.empty();
+}
+
+string sceneDump(const SceneConfig &c) {
+    string out;
+    char buf[64];
+    for (const SceneParam &p : c.params) {
+        out += p.name;
+        out += " = ";
+        switch (p.kind) {
+        case SceneParamKind::Int:    snprintf(buf, sizeof(buf), "%d", *static_cast<const int*>(p.ptr)); out += buf; break;
+        case SceneParamKind::Float:  snprintf(buf, sizeof(buf), "%.9g", *static_cast<const float*>(p.ptr)); out += buf; break;
+        case SceneParamKind::Double: snprintf(buf, sizeof(buf), "%.17g", *static_cast<const double*>(p.ptr)); out += buf; break;
+        case SceneParamKind::Bool:   out += *static_cast<const bool*>(p.ptr) ? "true" : "false"; break;
+        case SceneParamKind::U64:    snprintf(buf, sizeof(buf), "0x%" PRIx64, *static_cast<const uint64_t*>(p.ptr)); out += buf; break;
+        case SceneParamKind::String: out += *static_cast<const string*>(p.ptr); break;
+        }
+        out += '\n';
+    }
+    return out;
+}
@@ -0,0 +1,50 @@
+// scene_config.hpp
+// Named scene parameters bound to existing variables, set from a scene file
+// ("KEY = value" per line, '#' comments) or from "KEY=VALUE" command line overrides.
+// No GL dependency.
+//
+// Each binding carries a dirty mask chosen by the caller. Setting a parameter to a
+// different value ORs its mask into the caller's accumulator, so the renderer rebuilds
+// only what the change touches.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class SceneParamKind { Int, Float, Double, Bool, U64, String };
+
+struct SceneParam {
+    std::string name;
+    SceneParamKind kind;
+    void *ptr;
+    unsigned dirty;
+};
+
+struct SceneConfig {
+    std::vector<SceneParam> params;                     // in binding order (used by sceneDump)
+    std::unordered_map<std::string, size_t> index;
+};
+
+void sceneBind(SceneConfig &c, const char *name, int &v, unsigned dirty = 0);
+void sceneBind(SceneConfig &c, const char *name, float &v, unsigned dirty = 0);
+void sceneBind(SceneConfig &c, const char *name, double &v, unsigned dirty = 0);
+void sceneBind(SceneConfig &c, const char *name, bool &v, unsigned dirty = 0);
+void sceneBind(SceneConfig &c, const char *name, uint64_t &v, unsigned dirty = 0);
+void sceneBind(SceneConfig &c, const char *name, std::string &v, unsigned dirty = 0);
+
+// Parses `value` for parameter `key`. Returns false (and leaves the variable alone)
+// on an unknown key or a malformed value.
+bool sceneSet(SceneConfig &c, const std::string &key, const std::string &value,
+              unsigned &dirty, std::string &error);
+// "KEY=VALUE"
+bool sceneSetAssignment(SceneConfig &c, const std::string &assignment,
+                        unsigned &dirty, std::string &error);
+// Applies every line of the file; keeps going after a bad line and reports all of
+// them as "path:line: message" in `error`.
+bool sceneLoadFile(SceneConfig &c, const std::string &path, unsigned &dirty, std::string &error);
+
+// Current values in the scene file format (loads back to the same state)
+std::string sceneDump(const SceneConfig &c);
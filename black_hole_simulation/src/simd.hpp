@@ -0,0 +1,229 @@
+// simd.hpp
+// Minimal float lane type shared by the CPU physics kernels (N-body, geodesics, fields).
+// Picks AVX (8 lanes), SSE2 (4 lanes), NEON (4 lanes) or a scalar fallback at compile
+// time. Only the handful of operations the kernels need are provided.
+// vdouble is the double counterpart (half the lanes; scalar on 32-bit NEON), with only
+// arithmetic, sqrt, min / max and vselectLess.
+// Define BH_SIMD_SCALAR to force the scalar path (useful to compare results).
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if !defined(BH_SIMD_SCALAR) && defined(__AVX__)
+    #include <immintrin.h>
+    #define BH_SIMD_AVX 1
+#elif !defined(BH_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define BH_SIMD_SSE 1
+#elif !defined(BH_SIMD_SCALAR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+    #include <arm_neon.h>
+    #define BH_SIMD_NEON 1
+#endif
+
+#if defined(BH_SIMD_AVX)
+
+struct vfloat {
+    static const int width = 8;
+    __m256 v;
+    vfloat() {}
+    vfloat(__m256 x) : v(x) {}
+    explicit vfloat(float s) : v(_mm256_set1_ps(s)) {}
+    static vfloat load(const float *p) { return _mm256_loadu_ps(p); }
+    void store(float *p) const { _mm256_storeu_ps(p, v); }
+};
+inline vfloat operator+(vfloat a, vfloat b) { return _mm256_add_ps(a.v, b.v); }
+inline vfloat operator-(vfloat a, vfloat b) { return _mm256_sub_ps(a.v, b.v); }
+inline vfloat operator*(vfloat a, vfloat b) { return _mm256_mul_ps(a.v, b.v); }
+inline vfloat operator/(vfloat a, vfloat b) { return _mm256_div_ps(a.v, b.v); }
+inline vfloat vsqrt(vfloat a) { return _mm256_sqrt_ps(a.v); }
+inline vfloat vmin(vfloat a, vfloat b) { return _mm256_min_ps(a.v, b.v); }
+inline vfloat vmax(vfloat a, vfloat b) { return _mm256_max_ps(a.v, b.v); }
+// lanes where a < b keep t, others f
+inline vfloat vselectLess(vfloat a, vfloat b, vfloat t, vfloat f) {
+    return _mm256_blendv_ps(f.v, t.v, _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ));
+}
+inline float vhsum(vfloat a) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(a.v), _mm256_extractf128_ps(a.v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+struct vdouble {
+    static const int width = 4;
+    __m256d v;
+    vdouble() {}
+    vdouble(__m256d x) : v(x) {}
+    explicit vdouble(double s) : v(_mm256_set1_pd(s)) {}
+    static vdouble load(const double *p) { return _mm256_loadu_pd(p); }
+    void store(double *p) const { _mm256_storeu_pd(p, v); }
+};
+inline vdouble operator+(vdouble a, vdouble b) { return _mm256_add_pd(a.v, b.v); }
+inline vdouble operator-(vdouble a, vdouble b) { return _mm256_sub_pd(a.v, b.v); }
+inline vdouble operator*(vdouble a, vdouble b) { return _mm256_mul_pd(a.v, b.v); }
+inline vdouble operator/(vdouble a, vdouble b) { return _mm256_div_pd(a.v, b.v); }
+inline vdouble vsqrt(vdouble a) { return _mm256_sqrt_pd(a.v); }
+inline vdouble vmin(vdouble a, vdouble b) { return _mm256_min_pd(a.v, b.v); }
+inline vdouble vmax(vdouble a, vdouble b) { return _mm256_max_pd(a.v, b.v); }
+inline vdouble vselectLess(vdouble a, vdouble b, vdouble t, vdouble f) {
+    return _mm256_blendv_pd(f.v, t.v, _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ));
+}
+
+#elif defined(BH_SIMD_SSE)
+
+struct vfloat {
+    static const int width = 4;
+    __m128 v;
+    vfloat() {}
+    vfloat(__m128 x) : v(x) {}
+    explicit vfloat(float s) : v(_mm_set1_ps(s)) {}
+    static vfloat load(const float *p) { return _mm_loadu_ps(p); }
+    void store(float *p) const { _mm_storeu_ps(p, v); }
+};
+inline vfloat operator+(vfloat a, vfloat b) { return _mm_add_ps(a.v, b.v); }
+inline vfloat operator-(vfloat a, vfloat b) { return _mm_sub_ps(a.v, b.v); }
+inline vfloat operator*(vfloat a, vfloat b) { return _mm_mul_ps(a.v, b.v); }
+inline vfloat operator/(vfloat a, vfloat b) { return _mm_div_ps(a.v, b.v); }
+inline vfloat vsqrt(vfloat a) { return _mm_sqrt_ps(a.v); }
+inline vfloat vmin(vfloat a, vfloat b) { return _mm_min_ps(a.v, b.v); }
+inline vfloat vmax(vfloat a, vfloat b) { return _mm_max_ps(a.v, b.v); }
+inline vfloat vselectLess(vfloat a, vfloat b, vfloat t, vfloat f) {
+    __m128 m = _mm_cmplt_ps(a.v, b.v);
+    return _mm_or_ps(_mm_and_ps(m, t.v), _mm_andnot_ps(m, f.v));
+}
+inline float vhsum(vfloat a) {
+    __m128 s = _mm_add_ps(a.v, _mm_movehl_ps(a.v, a.v));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+struct vdouble {
+    static const int width = 2;
+    __m128d v;
+    vdouble() {}
+    vdouble(__m128d x) : v(x) {}
+    explicit vdouble(double s) : v(_mm_set1_pd(s)) {}
+    static vdouble load(const double *p) { return _mm_loadu_pd(p); }
+    void store(double *p) const { _mm_storeu_pd(p, v); }
+};
+inline vdouble operator+(vdouble a, vdouble b) { return _mm_add_pd(a.v, b.v); }
+inline vdouble operator-(vdouble a, vdouble b) { return _mm_sub_pd(a.v, b.v); }
+inline vdouble operator*(vdouble a, vdouble b) { return _mm_mul_pd(a.v, b.v); }
+inline vdouble operator/(vdouble a, vdouble b) { return _mm_div_pd(a.v, b.v); }
+inline vdouble vsqrt(vdouble a) { return _mm_sqrt_pd(a.v); }
+inline vdouble vmin(vdouble a, vdouble b) { return _mm_min_pd(a.v, b.v); }
+inline vdouble vmax(vdouble a, vdouble b) { return _mm_max_pd(a.v, b.v); }
+inline vdouble vselectLess(vdouble a, vdouble b, vdouble t, vdouble f) {
+    __m128d m = _mm_cmplt_pd(a.v, b.v);
+    return _mm_or_pd(_mm_and_pd(m, t.v), _mm_andnot_pd(m, f.v));
+}
+
+#elif defined(BH_SIMD_NEON)
+
+struct vfloat {
+    static const int width = 4;
+    float32x4_t v;
+    vfloat() {}
+    vfloat(float32x4_t x) : v(x) {}
+    explicit vfloat(float s) : v(vdupq_n_f32(s)) {}
+    static vfloat load(const float *p) { return vld1q_f32(p); }
+    void store(float *p) const { vst1q_f32(p, v); }
+};
+inline vfloat operator+(vfloat a, vfloat b) { return vaddq_f32(a.v, b.v); }
+inline vfloat operator-(vfloat a, vfloat b) { return vsubq_f32(a.v, b.v); }
+inline vfloat operator*(vfloat a, vfloat b) { return vmulq_f32(a.v, b.v); }
+#if defined(__aarch64__)
+inline vfloat operator/(vfloat a, vfloat b) { return vdivq_f32(a.v, b.v); }
+inline vfloat vsqrt(vfloat a) { return vsqrtq_f32(a.v); }
+inline float vhsum(vfloat a) { return vaddvq_f32(a.v); }
+#else
+inline vfloat operator/(vfloat a, vfloat b) {
+    float x[4], y[4]; vst1q_f32(x, a.v); vst1q_f32(y, b.v);
+    for (int i = 0; i < 4; ++i) x[i] /= y[i];
+    return vld1q_f32(x);
+}
+inline vfloat vsqrt(vfloat a) {
+    float x[4]; vst1q_f32(x, a.v);
+    for (int i = 0; i < 4; ++i) x[i] = std::sqrt(x[i]);
+    return vld1q_f32(x);
+}
+inline float vhsum(vfloat a) {
+    float32x2_t s = vadd_f32(vget_low_f32(a.v), vget_high_f32(a.v));
+    return vget_lane_f32(vpadd_f32(s, s), 0);
+}
+#endif
+inline vfloat vmin(vfloat a, vfloat b) { return vminq_f32(a.v, b.v); }
+inline vfloat vmax(vfloat a, vfloat b) { return vmaxq_f32(a.v, b.v); }
+inline vfloat vselectLess(vfloat a, vfloat b, vfloat t, vfloat f) { return vbslq_f32(vcltq_f32(a.v, b.v), t.v, f.v); }
+
+#if defined(__aarch64__)
+struct vdouble {
+    static const int width = 2;
+    float64x2_t v;
+    vdouble() {}
+    vdouble(float64x2_t x) : v(x) {}
+    explicit vdouble(double s) : v(vdupq_n_f64(s)) {}
+    static vdouble load(const double *p) { return vld1q_f64(p); }
+    void store(double *p) const { vst1q_f64(p, v); }
+};
+inline vdouble operator+(vdouble a, vdouble b) { return vaddq_f64(a.v, b.v); }
+inline vdouble operator-(vdouble a, vdouble b) { return vsubq_f64(a.v, b.v); }
+inline vdouble operator*(vdouble a, vdouble b) { return vmulq_f64(a.v, b.v); }
+inline vdouble operator/(vdouble a, vdouble b) { return vdivq_f64(a.v, b.v); }
+inline vdouble vsqrt(vdouble a) { return vsqrtq_f64(a.v); }
+inline vdouble vmin(vdouble a, vdouble b) { return vminq_f64(a.v, b.v); }
+inline vdouble vmax(vdouble a, vdouble b) { return vmaxq_f64(a.v, b.v); }
+inline vdouble vselectLess(vdouble a, vdouble b, vdouble t, vdouble f) { return vbslq_f64(vcltq_f64(a.v, b.v), t.v, f.v); }
+#else
+#define BH_SIMD_SCALAR_DOUBLE 1
+#endif
+
+#else
+
+struct vfloat {
+    static const int width = 1;
+    float v;
+    vfloat() {}
+    explicit vfloat(float s) : v(s) {}
+    static vfloat load(const float *p) { return vfloat(*p); }
+    void store(float *p) const { *p = v; }
+};
+inline vfloat operator+(vfloat a, vfloat b) { return vfloat(a.v + b.v); }
+inline vfloat operator-(vfloat a, vfloat b) { return vfloat(a.v - b.v); }
+inline vfloat operator*(vfloat a, vfloat b) { return vfloat(a.v * b.v); }
+inline vfloat operator/(vfloat a, vfloat b) { return vfloat(a.v / b.v); }
+inline vfloat vsqrt(vfloat a) { return vfloat(std::sqrt(a.v)); }
+inline vfloat vmin(vfloat a, vfloat b) { return vfloat(a.v < b.v ? a.v : b.v); }
+inline vfloat vmax(vfloat a, vfloat b) { return vfloat(a.v < b.v ? b.v : a.v); }
+inline vfloat vselectLess(vfloat a, vfloat b, vfloat t, vfloat f) { return a.v < b.v ? t : f; }
+inline float vhsum(vfloat a) { return a.v; }
+
+#define BH_SIMD_SCALAR_DOUBLE 1
+
+#endif
+
+#if defined(BH_SIMD_SCALAR_DOUBLE)
+struct vdouble {
+    static const int width = 1;
+    double v;
+    vdouble() {}
+    explicit vdouble(double s) : v(s) {}
+    static vdouble load(const double *p) { return vdouble(*p); }
+    void store(double *p) const { *p = v; }
+};
+inline vdouble operator+(vdouble a, vdouble b) { return vdouble(a.v + b.v); }
+inline vdouble operator-(vdouble a, vdouble b) { return vdouble(a.v - b.v); }
+inline vdouble operator*(vdouble a, vdouble b) { return vdouble(a.v * b.v); }
+inline vdouble operator/(vdouble a, vdouble b) { return vdouble(a.v / b.v); }
+inline vdouble vsqrt(vdouble a) { return vdouble(std::sqrt(a.v)); }
+inline vdouble vmin(vdouble a, vdouble b) { return vdouble(a.v < b.v ? a.v : b.v); }
+inline vdouble vmax(vdouble a, vdouble b) { return vdouble(a.v < b.v ? b.v : a.v); }
+inline vdouble vselectLess(vdouble a, vdouble b, vdouble t, vdouble f) { return a.v < b.v ? t : f; }
+#endif
+
+inline vfloat& operator+=(vfloat &a, vfloat b) { a = a + b; return a; }
+inline vfloat& operator-=(vfloat &a, vfloat b) { a = a - b; return a; }
+inline vdouble& operator+=(vdouble &a, vdouble b) { a = a + b; return a; }
+inline vdouble& operator-=(vdouble &a, vdouble b) { a = a - b; return a; }
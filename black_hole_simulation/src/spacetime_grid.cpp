@@ -0,0 +1,203 @@
+// spacetime_grid.cpp
+// Uniform and adaptive (quadtree) background grids, see spacetime_grid.hpp.
+
+#include "spacetime_grid.hpp"
+#include "metric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+void generateGridGeometry(GridGeometry &g, int gridSize, float spacing, float massScale) {
+    g.verts.clear(); g.indices.clear();
+    int N = gridSize*2 + 1;
+    for (int z=-gridSize; z<=gridSize; ++z){
+        for (int x=-gridSize; x<=gridSize; ++x){
+            float fx = x * spacing;
+            float fz = z * spacing;
+            float r = sqrt(fx*fx + fz*fz);
+            float fy = gridDisplacement(r, massScale);
+            g.verts.push_back({ fx, fy - 0.28f, fz });
+        }
+    }
+    for (int z=0; z<N; ++z){
+        for (int x=0; x<N; ++x){
+            int i = z*N + x;
+            if (x < N-1) { g.indices.push_back(i); g.indices.push_back(i+1); }
+            if (z < N-1) { g.indices.push_back(i); g.indices.push_back(i+N); }
+        }
+    }
+}
+
+void generateGridSurface(GridGeometry &g, int gridSize, float spacing, float massScale) {
+    generateGridGeometry(g, gridSize, spacing, massScale);
+    g.indices.clear();
+    unsigned int N = gridSize*2 + 1;
+    g.indices.reserve(size_t(N-1) * (N-1) * 6);
+    for (unsigned int z=0; z+1<N; ++z){
+        for (unsigned int x=0; x+1<N; ++x){
+            unsigned int i = z*N + x;
+            g.indices.insert(g.indices.end(), { i, i+1, i+N, i+1, i+N+1, i+N });
+        }
+    }
+}
+
+static float adaptiveGridLatticeStep(const AdaptiveGrid &ag) {
+    return (2.0f * ag.extent) / float(ag.rootCells << ag.maxDepth);
+}
+
+static bool adaptiveGridShouldSplit(const AdaptiveGrid &ag, const GridQuadNode &n, float camRadius) {
+    if (n.size <= 1) return false;
+    float step = adaptiveGridLatticeStep(ag);
+    float x0 = -ag.extent + n.lx * step, z0 = -ag.extent + n.lz * step;
+    float h = n.size * step;
+    // nearest point of the cell to the well center (where |y''| peaks)
+    float nx = min(max(0.0f, x0), x0 + h);
+    float nz = min(max(0.0f, z0), z0 + h);
+    float rMin = sqrt(nx*nx + nz*nz);
+    float cx = x0 + 0.5f*h, cz = z0 + 0.5f*h;
+    float viewDist = sqrt(camRadius*camRadius + cx*cx + cz*cz);
+    // linear interpolation error over the cell ~ |y''| h^2 / 8, projected by view distance
+    float err = gridDisplacementCurvature(rMin, ag.massScale) * h * h * 0.125f;
+    if (err / viewDist > ag.curvatureTol) return true;
+    return h / viewDist > ag.angularTol;
+}
+
+static void adaptiveGridCollapse(AdaptiveGrid &ag, int idx) {
+    int c = ag.nodes[idx].child;
+    if (c < 0) return;
+    for (int k=0; k<4; ++k) adaptiveGridCollapse(ag, c + k);
+    // children are allocated as a contiguous block of 4; recycle the block head
+    ag.freeNodes.push_back(c);
+    ag.nodes[idx].child = -1;
+}
+
+// Returns true if the subtree changed
+static bool adaptiveGridRefine(AdaptiveGrid &ag, int idx, float camRadius) {
+    GridQuadNode n = ag.nodes[idx];
+    bool split = adaptiveGridShouldSplit(ag, n, camRadius);
+    if (!split) {
+        if (n.child < 0) return false;
+        adaptiveGridCollapse(ag, idx);
+        return true;
+    }
+    bool changed = false;
+    if (n.child < 0) {
+        int hs = n.size / 2;
+        GridQuadNode c0 = { n.lx,      n.lz,      hs, -1 };
+        GridQuadNode c1 = { n.lx + hs, n.lz,      hs, -1 };
+        GridQuadNode c2 = { n.lx,      n.lz + hs, hs, -1 };
+        GridQuadNode c3 = { n.lx + hs, n.lz + hs, hs, -1 };
+        int first;
+        if (!ag.freeNodes.empty()) {
+            first = ag.freeNodes.back(); ag.freeNodes.pop_back();
+        } else {
+            first = (int)ag.nodes.size();
+            ag.nodes.resize(ag.nodes.size() + 4);
+        }
+        ag.nodes[first] = c0; ag.nodes[first+1] = c1; ag.nodes[first+2] = c2; ag.nodes[first+3] = c3;
+        ag.nodes[idx].child = first;
+        changed = true;
+    }
+    int first = ag.nodes[idx].child;
+    for (int k=0; k<4; ++k) changed |= adaptiveGridRefine(ag, first + k, camRadius);
+    return changed;
+}
+
+static void adaptiveGridBuildMesh(AdaptiveGrid &ag) {
+    GridGeometry &g = ag.geometry;
+    g.verts.clear(); g.indices.clear();
+    const int latticeN = (ag.rootCells << ag.maxDepth) + 1;
+    const float step = adaptiveGridLatticeStep(ag);
+    auto key = [latticeN](int lx, int lz) { return (uint64_t)lz * (uint64_t)latticeN + (uint64_t)lx; };
+
+    vector<int> leaves;
+    leaves.reserve(ag.nodes.size());
+    vector<int> stack;
+    for (int r=0; r<ag.rootCells*ag.rootCells; ++r) stack.push_back(r);
+    while (!stack.empty()) {
+        int idx = stack.back(); stack.pop_back();
+        const GridQuadNode &n = ag.nodes[idx];
+        if (n.child < 0) { leaves.push_back(idx); continue; }
+        for (int k=0; k<4; ++k) stack.push_back(n.child + k);
+    }
+    ag.leafCount = (int)leaves.size();
+
+    // weld leaf corners on the lattice
+    unordered_map<uint64_t, unsigned int> vertIndex;
+    vertIndex.reserve(leaves.size() * 2);
+    auto addVert = [&](int lx, int lz) {
+        uint64_t k = key(lx, lz);
+        auto it = vertIndex.find(k);
+        if (it != vertIndex.end()) return;
+        float fx = -ag.extent + lx * step;
+        float fz = -ag.extent + lz * step;
+        float r = sqrt(fx*fx + fz*fz);
+        vertIndex.emplace(k, (unsigned int)g.verts.size());
+        g.verts.push_back({ fx, gridDisplacement(r, ag.massScale) - 0.28f, fz });
+    };
+    for (int idx : leaves) {
+        const GridQuadNode &n = ag.nodes[idx];
+        addVert(n.lx, n.lz);          addVert(n.lx + n.size, n.lz);
+        addVert(n.lx, n.lz + n.size); addVert(n.lx + n.size, n.lz + n.size);
+    }
+
+    // emit edges, split wherever a finer neighbour put a vertex on them
+    unordered_set<uint64_t> emitted;
+    emitted.reserve(leaves.size() * 4);
+    auto emitEdge = [&](int lx, int lz, int dx, int dz, int len) {
+        unsigned int prev = vertIndex[key(lx, lz)];
+        for (int s=1; s<=len; ++s) {
+            auto it = vertIndex.find(key(lx + dx*s, lz + dz*s));
+            if (it == vertIndex.end()) continue;
+            unsigned int a = min(prev, it->second), b = max(prev, it->second);
+            if (emitted.insert(((uint64_t)a << 32) | b).second) {
+                g.indices.push_back(a); g.indices.push_back(b);
+            }
+            prev = it->second;
+        }
+    };
+    for (int idx : leaves) {
+        const GridQuadNode &n = ag.nodes[idx];
+        emitEdge(n.lx, n.lz, 1, 0, n.size);
+        emitEdge(n.lx, n.lz, 0, 1, n.size);
+        emitEdge(n.lx + n.size, n.lz, 0, 1, n.size);
+        emitEdge(n.lx, n.lz + n.size, 1, 0, n.size);
+    }
+}
+
+bool updateAdaptiveGrid(AdaptiveGrid &ag, float camRadius) {
+    int bucket = (int)floor(log(max(camRadius, 1e-3f)) / log(ag.lodBucketStep));
+    bool first = ag.nodes.empty();
+    if (!first && bucket == ag.lodBucket) return false;
+    ag.lodBucket = bucket;
+
+    bool changed = first;
+    if (first) {
+        ag.budgetBucket = INT_MIN;
+        int rootSize = 1 << ag.maxDepth;
+        for (int rz=0; rz<ag.rootCells; ++rz)
+            for (int rx=0; rx<ag.rootCells; ++rx)
+                ag.nodes.push_back({ rx*rootSize, rz*rootSize, rootSize, -1 });
+    }
+    // over the budget: refine for one bucket further out and try again (bounded, the
+    // root cells alone are always within any sane budget)
+    const int start = max(bucket, ag.budgetBucket);
+    for (int b = start; b < start + 64; ++b) {
+        ag.lodRadius = pow(ag.lodBucketStep, float(b) + 0.5f);
+        bool refined = false;
+        for (int r=0; r<ag.rootCells*ag.rootCells; ++r)
+            refined |= adaptiveGridRefine(ag, r, ag.lodRadius);
+        changed |= refined;
+        if (refined || ag.geometry.verts.empty()) adaptiveGridBuildMesh(ag);
+        if (ag.vertexBudget <= 0 || (int)ag.geometry.verts.size() <= ag.vertexBudget) {
+            if (b > bucket) ag.budgetBucket = b;
+            break;
+        }
+    }
+    return changed;
+}
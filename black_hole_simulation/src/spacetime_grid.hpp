@@ -0,0 +1,65 @@
+// spacetime_grid.hpp
+// Line meshes of the curved background grid (y = gridDisplacement(r)), built on the
+// CPU with no GL dependency; the renderer uploads GridGeometry as-is (GridVertex has
+// the layout of a vec3).
+//
+// generateGridGeometry is the uniform lattice. AdaptiveGrid is the same surface with
+// cells refined only where the displacement bends (|y''| large, i.e. near r=0) and
+// where the camera is close. Cell corners live on an integer lattice of the finest
+// cell size, so vertices shared between neighbouring leaves are welded, and every
+// leaf edge is split at the corners of finer neighbours (no cracks at T-junctions).
+//
+// The tree is kept between frames: when the camera radius moves to another LOD bucket
+// only the nodes whose split decision changed are refined/collapsed.
+//
+// vertexBudget caps the mesh: if a bucket would refine past it (close zoom), the tree is
+// refined for the next bucket out instead, until it fits. Vertex count only grows as
+// the radius shrinks, so the first bucket that fits is remembered and closer zoom
+// levels reuse it without rebuilding. By default the budget is the
+// uniform lattice's vertex count, so the adaptive grid never has more vertices.
+
+#pragma once
+
+#include <climits>
+#include <vector>
+
+struct GridVertex { float x, y, z; };
+
+struct GridGeometry {
+    std::vector<GridVertex> verts;
+    std::vector<unsigned int> indices;      // GL_LINES pairs (GL_TRIANGLES for a surface)
+};
+
+// (2*gridSize+1)^2 vertices `spacing` apart, 4-connected
+void generateGridGeometry(GridGeometry &g, int gridSize=28, float spacing=0.12f, float massScale=3.2f);
+// Same vertices, indices are GL_TRIANGLES pairs per cell (the filled surface the field
+// overlay is drawn on)
+void generateGridSurface(GridGeometry &g, int gridSize, float spacing, float massScale=3.2f);
+
+struct GridQuadNode {
+    int lx, lz;     // lattice coords of the min corner
+    int size;       // edge length in lattice units
+    int child;      // index of first of 4 children, -1 for leaf
+};
+
+struct AdaptiveGrid {
+    int rootCells = 8;          // roots per side
+    int maxDepth = 6;           // finest cell = root / 2^maxDepth
+    float extent = 3.36f;       // half size (same footprint as generateGridGeometry(28, 0.12))
+    float massScale = 3.2f;
+    float curvatureTol = 0.004f;  // allowed interpolation error / view distance
+    float angularTol = 0.16f;     // allowed cell size / view distance
+    float lodBucketStep = 1.12f;  // camera radius ratio between rebuilds
+    int vertexBudget = 57 * 57;   // generateGridGeometry(28) vertex count; 0 = unlimited
+    std::vector<GridQuadNode> nodes;
+    std::vector<int> freeNodes;
+    int lodBucket = INT_MIN;
+    int budgetBucket = INT_MIN;   // innermost bucket known to fit vertexBudget
+    float lodRadius = 0.0f;       // radius the tree is refined for (>= the bucket's)
+    int leafCount = 0;
+    GridGeometry geometry;
+};
+
+// Refine/collapse the tree for the current camera distance; rebuilds geometry only if
+// it changed. Returns true when it was rebuilt (and needs uploading).
+bool updateAdaptiveGrid(AdaptiveGrid &ag, float camRadius);
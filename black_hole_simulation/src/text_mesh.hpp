@@ -0,0 +1,21 @@
+// text_mesh.hpp
+// On-screen text as points: one TextPoint per lit pixel of a small 5x7 bitmap font,
+// drawn with GL_POINTS by the renderer. No GL dependency.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct TextPoint {
+    float x, y; // screen space normalized (0..1), we'll convert to clip space in shader or feed ortho
+    float r, g, b, a;
+};
+
+// Map ASCII char to font index (space for unsupported chars)
+int asciiToFontIndex(char c);
+
+// Appends the points of `text` to outPoints. originX, originY in normalized screen
+// coords (0..1), top-left of the first char; scale = relative size (0..1)
+void buildTextMesh(const std::string &text, float originX, float originY, float scale,
+                   float r, float g, float b, std::vector<TextPoint> &outPoints);
@@ -0,0 +1,40 @@
+// units.hpp
+// Geometrized units: G = c = 1 and the hole mass M = 1, so lengths and times are in
+// units of M (geodesic.hpp, photon_ring.hpp and the field API work this way; the
+// N-body module uses G = 1 in scene units). SI only appears when converting inputs
+// and results.
+//
+// Why: in SI the numbers span ~90 orders of magnitude. For Sgr A* (8.54e36 kg, the
+// mass the original engine used) G^2 M^2 is 3e53, which is already inf in float, while
+// in geometrized units every quantity near the hole is O(1).
+
+#pragma once
+
+namespace units {
+
+constexpr double G = 6.67430e-11;            // m^3 kg^-1 s^-2
+constexpr double c = 299792458.0;             // m / s
+constexpr double solarMass = 1.98847e30;      // kg
+constexpr double sagittariusAMass = 8.54e36;  // kg
+
+// What one unit of M is worth in SI for a hole of mass massKg
+struct GeometrizedScale {
+    double massKg = 0.0;
+    double meters = 0.0;      // G M / c^2 (half the Schwarzschild radius)
+    double seconds = 0.0;     // G M / c^3
+
+    double toMeters(double lengthM) const { return lengthM * meters; }
+    double toSeconds(double timeM) const { return timeM * seconds; }
+    double fromMeters(double m) const { return m / meters; }
+    double fromSeconds(double s) const { return s / seconds; }
+};
+
+inline GeometrizedScale geometrizedScale(double massKg) {
+    GeometrizedScale s;
+    s.massKg = massKg;
+    s.meters = G * massKg / (c * c);
+    s.seconds = s.meters / c;
+    return s;
+}
+
+} // namespace units
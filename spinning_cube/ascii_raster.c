@@ -0,0 +1,745 @@
+// ascii_raster.c
+// CPU side of the ASCII cubes, see ascii_raster.h.
+
+#include "ascii_raster.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <malloc.h>                    // _aligned_malloc
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ASCII buffer & z-buffer, width_chars x height_chars, cache-line aligned
+float* zBuffer = NULL;
+unsigned char* charBuffer = NULL; // stores ASCII code
+const unsigned char backgroundASCIICode = '.';
+
+// Cubes parameters (kept from original)
+float A = 0.0f, B = 0.0f, C = 0.0f;
+static float cubeWidth = 20.0f;
+int width_chars = DEFAULT_COLS;
+int height_chars = DEFAULT_ROWS;
+static float distanceFromCam = 100.0f;
+static float horizontalOffset = 0.0f;
+static float K1 = 40.0f;
+float incrementSpeed = 0.6f;           // sample spacing on the faces at the current grid size
+float baseStep = 0.6f;                 // sample spacing at the default grid size
+float gridScale = 1.0f;                // grid size relative to DEFAULT_COLS x DEFAULT_ROWS
+float sampleLattice = 1.0f;            // sample lattice at the default grid size
+static float sampleQuantum = 1.0f;     // lattice the samples snap to: sampleLattice up to the default
+                                       // grid, sampleLattice / gridScale on larger ones
+
+// Per-cell buffers start on a cache line and are padded to whole lines, so the
+// per-worker depth buffers never share a line with each other
+#define CACHE_LINE 64
+void* alloc_aligned(size_t bytes) {
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;   // aligned_alloc wants a multiple
+    if (bytes == 0) bytes = CACHE_LINE;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, CACHE_LINE);
+#else
+    return aligned_alloc(CACHE_LINE, bytes);
+#endif
+}
+
+void free_aligned(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+// ========== Soft ASCII projection math (copied from original) ==========
+// Truncation toward zero onto the sample lattice; (int)c at sampleQuantum = 1
+static float quantize_sample(float c) {
+    return (float)(int)(c / sampleQuantum) * sampleQuantum;
+}
+
+static float calculateX(float i, float j, float k) {
+    return j * sinf(A) * sinf(B) * cosf(C) - k * cosf(A) * sinf(B) * cosf(C) +
+           j * cosf(A) * sinf(C) + k * sinf(A) * sinf(C) + i * cosf(B) * cosf(C);
+}
+
+static float calculateY(float i, float j, float k) {
+    return j * cosf(A) * cosf(C) + k * sinf(A) * cosf(C) -
+           j * sinf(A) * sinf(B) * sinf(C) + k * cosf(A) * sinf(B) * sinf(C) -
+           i * cosf(B) * sinf(C);
+}
+
+static float calculateZ(float i, float j, float k) {
+    return k * cosf(A) * cosf(B) - j * sinf(A) * cosf(B) + i * sinf(B);
+}
+
+static void calculateForSurface(float cubeX, float cubeY, float cubeZ, int ch) {
+    float i = quantize_sample(cubeX), j = quantize_sample(cubeY), k = quantize_sample(cubeZ);
+    float x = calculateX(i, j, k);
+    float y = calculateY(i, j, k);
+    float z = calculateZ(i, j, k) + distanceFromCam;
+
+    float ooz = 1.0f / z;
+
+    int xp = (int)(width_chars / 2 + horizontalOffset + K1 * ooz * x * 2.0f);
+    int yp = (int)(height_chars / 2 + K1 * ooz * y);
+
+    int idx = xp + yp * width_chars;
+    if (idx >= 0 && idx < width_chars * height_chars) {
+        if (ooz > zBuffer[idx]) {
+            zBuffer[idx] = ooz;
+            charBuffer[idx] = (unsigned char)ch;
+        }
+    }
+}
+
+// Reference path: the original per-sample trig, kept for --bench
+void render_ascii_cubes_reference(void) {
+    // clear
+    for (int i = 0; i < width_chars * height_chars; ++i) {
+        zBuffer[i] = 0.0f;
+        charBuffer[i] = backgroundASCIICode;
+    }
+
+    cubeWidth = 20.0f;
+    horizontalOffset = -2.0f * cubeWidth * gridScale;
+    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
+        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
+            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
+            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
+            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
+            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
+            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
+            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
+        }
+    }
+
+    cubeWidth = 10.0f;
+    horizontalOffset = 1.0f * cubeWidth * gridScale;
+    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
+        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
+            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
+            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
+            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
+            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
+            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
+            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
+        }
+    }
+
+    cubeWidth = 5.0f;
+    horizontalOffset = 8.0f * cubeWidth * gridScale;
+    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
+        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
+            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
+            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
+            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
+            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
+            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
+            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
+        }
+    }
+}
+
+// ========== Per-frame transform + batched samples ==========
+// The surface samples do not depend on the angles, so each cube keeps its sample
+// coordinates (already on the sample lattice, as calculateForSurface does) and the face
+// char in flat arrays. Per frame the rotation matrix is built once from A, B, C; the
+// raster kernel then transforms, projects and depth-tests whole arrays in the
+// original order, so depth ties resolve the same way.
+
+typedef struct { float m[3][3]; } Rot3;
+
+// Rows are the coefficients of i, j, k in calculateX / calculateY / calculateZ
+static void rotation_from_angles(Rot3* r, float a, float b, float c) {
+    float sa = sinf(a), ca = cosf(a);
+    float sb = sinf(b), cb = cosf(b);
+    float sc = sinf(c), cc = cosf(c);
+    r->m[0][0] = cb * cc;  r->m[0][1] = sa * sb * cc + ca * sc;  r->m[0][2] = sa * sc - ca * sb * cc;
+    r->m[1][0] = -cb * sc; r->m[1][1] = ca * cc - sa * sb * sc;  r->m[1][2] = sa * cc + ca * sb * sc;
+    r->m[2][0] = sb;       r->m[2][1] = -sa * cb;                r->m[2][2] = ca * cb;
+}
+
+typedef struct {
+    float width, offset;             // cubeWidth, horizontalOffset of the original loops (default grid)
+    int count;
+    float *x, *y, *z;                // sample coordinates on the sampleQuantum lattice
+    unsigned char* ch;
+} CubeSamples;
+
+#define CUBE_COUNT 3
+static CubeSamples cubes[CUBE_COUNT];
+static Rot3 frameRot;
+
+// With a step below the lattice spacing several steps snap to the same point; only
+// the first copy is kept. A later copy of the same point and char can never pass the
+// depth test (the cell already holds at least its 1/z), so the output is unchanged
+// and the kernels skip the duplicate work.
+typedef struct {
+    int* slots;                      // sample index, -1 = empty
+    unsigned mask;
+} SampleSet;
+
+static uint32_t sample_hash(float x, float y, float z, unsigned char ch) {
+    uint32_t b[3];
+    memcpy(&b[0], &x, 4); memcpy(&b[1], &y, 4); memcpy(&b[2], &z, 4);
+    uint32_t h = 2166136261u ^ ch;
+    for (int i = 0; i < 3; ++i) {
+        h ^= b[i];
+        h *= 16777619u;
+        h ^= h >> 15;
+    }
+    return h;
+}
+
+static void push_sample(CubeSamples* s, SampleSet* set, float cx, float cy, float cz, unsigned char ch) {
+    float x = quantize_sample(cx), y = quantize_sample(cy), z = quantize_sample(cz);
+    uint32_t slot = sample_hash(x, y, z, ch) & set->mask;
+    for (;; slot = (slot + 1) & set->mask) {
+        int k = set->slots[slot];
+        if (k < 0) break;
+        if (s->x[k] == x && s->y[k] == y && s->z[k] == z && s->ch[k] == ch) return;
+    }
+    set->slots[slot] = s->count;
+    s->x[s->count] = x;
+    s->y[s->count] = y;
+    s->z[s->count] = z;
+    s->ch[s->count] = ch;
+    s->count++;
+}
+
+static int build_cube_samples(CubeSamples* s, float width, float offset) {
+    int steps = 0;
+    for (float v = -width; v < width; v += incrementSpeed) ++steps;
+    int cap = steps * steps * 6;
+    s->width = width;
+    s->offset = offset;
+    s->count = 0;
+    s->x = (float*)malloc(cap * sizeof(float));
+    s->y = (float*)malloc(cap * sizeof(float));
+    s->z = (float*)malloc(cap * sizeof(float));
+    s->ch = (unsigned char*)malloc(cap);
+    if (!s->x || !s->y || !s->z || !s->ch) return -1;
+    SampleSet set;
+    unsigned slots = 16;
+    while (slots < 2u * (unsigned)cap) slots *= 2;
+    set.mask = slots - 1;
+    set.slots = (int*)malloc(slots * sizeof(int));
+    if (!set.slots) return -1;
+    memset(set.slots, 0xff, slots * sizeof(int));
+    // same float stepping and face order as render_ascii_cubes_reference
+    for (float cubeX = -width; cubeX < width; cubeX += incrementSpeed) {
+        for (float cubeY = -width; cubeY < width; cubeY += incrementSpeed) {
+            push_sample(s, &set, cubeX, cubeY, -width, '@');
+            push_sample(s, &set, width, cubeY, cubeX, '$');
+            push_sample(s, &set, -width, cubeY, -cubeX, '~');
+            push_sample(s, &set, -cubeX, cubeY, width, '#');
+            push_sample(s, &set, cubeX, -width, -cubeY, ';');
+            push_sample(s, &set, cubeX, width, cubeY, '+');
+        }
+    }
+    free(set.slots);
+    return 0;
+}
+
+void free_cube_samples(void) {
+    for (int c = 0; c < CUBE_COUNT; ++c) {
+        free(cubes[c].x); free(cubes[c].y); free(cubes[c].z); free(cubes[c].ch);
+        memset(&cubes[c], 0, sizeof(cubes[c]));
+    }
+}
+
+// Rebuilds the samples with the current incrementSpeed / sampleQuantum
+static int init_cube_samples(void) {
+    free_cube_samples();
+    const float widths[CUBE_COUNT] = { 20.0f, 10.0f, 5.0f };
+    const float offsets[CUBE_COUNT] = { -2.0f * 20.0f, 1.0f * 10.0f, 8.0f * 5.0f };
+    for (int c = 0; c < CUBE_COUNT; ++c)
+        if (build_cube_samples(&cubes[c], widths[c], offsets[c]) != 0) return -1;
+    return 0;
+}
+
+// Per-frame transform stage: one set of sin/cos for the whole frame
+void begin_frame_transform(void) {
+    rotation_from_angles(&frameRot, A, B, C);
+}
+
+// ========== Raster kernel ==========
+// Reentrant: everything it reads or writes comes in through RasterTarget / RasterView,
+// so several calls can run at once on different targets. The SIMD variants transform
+// and project RASTER_LANES samples per iteration with the same operation order as the
+// scalar code (no FMA, true division), then depth-test those lanes in order.
+
+typedef struct {
+    Rot3 rot;
+    float distance, k1;
+    float centerX, centerY;          // cols/2 + horizontal offset, rows/2
+} RasterView;
+
+#define RASTER_LANES 8
+
+static RasterView raster_view(const RasterTarget* t, const Rot3* rot, float offset) {
+    RasterView v;
+    v.rot = *rot;
+    v.distance = distanceFromCam;
+    v.k1 = K1;
+    v.centerX = t->cols / 2 + offset;
+    v.centerY = (float)(t->rows / 2);
+    return v;
+}
+
+static inline void depth_test(const RasterTarget* t, int px, int py, float invZ, unsigned char ch) {
+    int idx = px + py * t->cols;
+    if (idx >= 0 && idx < t->cols * t->rows && invZ > t->zbuf[idx]) {
+        t->zbuf[idx] = invZ;
+        t->chars[idx] = ch;
+    }
+}
+
+static void raster_samples_scalar(const RasterTarget* t, const RasterView* v, const CubeSamples* s,
+                                  int begin, int end) {
+    const float (*m)[3] = v->rot.m;
+    for (int i = begin; i < end; ++i) {
+        float x = s->x[i], y = s->y[i], z = s->z[i];
+        float rx = m[0][0] * x + m[0][1] * y + m[0][2] * z;
+        float ry = m[1][0] * x + m[1][1] * y + m[1][2] * z;
+        float rz = m[2][0] * x + m[2][1] * y + m[2][2] * z;
+        float invZ = 1.0f / (rz + v->distance);
+        int px = (int)(v->centerX + v->k1 * invZ * rx * 2.0f);
+        int py = (int)(v->centerY + v->k1 * invZ * ry);
+        depth_test(t, px, py, invZ, s->ch[i]);
+    }
+}
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RASTER_SIMD_NAME "AVX2"
+
+static void raster_samples_simd(const RasterTarget* t, const RasterView* v, const CubeSamples* s,
+                                int begin, int end) {
+    const float (*m)[3] = v->rot.m;
+    const __m256 m00 = _mm256_set1_ps(m[0][0]), m01 = _mm256_set1_ps(m[0][1]), m02 = _mm256_set1_ps(m[0][2]);
+    const __m256 m10 = _mm256_set1_ps(m[1][0]), m11 = _mm256_set1_ps(m[1][1]), m12 = _mm256_set1_ps(m[1][2]);
+    const __m256 m20 = _mm256_set1_ps(m[2][0]), m21 = _mm256_set1_ps(m[2][1]), m22 = _mm256_set1_ps(m[2][2]);
+    const __m256 dist = _mm256_set1_ps(v->distance), k1 = _mm256_set1_ps(v->k1);
+    const __m256 cx = _mm256_set1_ps(v->centerX), cy = _mm256_set1_ps(v->centerY);
+    const __m256 one = _mm256_set1_ps(1.0f), two = _mm256_set1_ps(2.0f);
+    int px[RASTER_LANES], py[RASTER_LANES];
+    float invZ[RASTER_LANES];
+    int i = begin;
+    for (; i + RASTER_LANES <= end; i += RASTER_LANES) {
+        __m256 x = _mm256_loadu_ps(s->x + i), y = _mm256_loadu_ps(s->y + i), z = _mm256_loadu_ps(s->z + i);
+        __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z));
+        __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z));
+        __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z));
+        __m256 iz = _mm256_div_ps(one, _mm256_add_ps(rz, dist));
+        __m256 kz = _mm256_mul_ps(k1, iz);
+        __m256 fx = _mm256_add_ps(cx, _mm256_mul_ps(_mm256_mul_ps(kz, rx), two));
+        __m256 fy = _mm256_add_ps(cy, _mm256_mul_ps(kz, ry));
+        _mm256_storeu_si256((__m256i*)px, _mm256_cvttps_epi32(fx));
+        _mm256_storeu_si256((__m256i*)py, _mm256_cvttps_epi32(fy));
+        _mm256_storeu_ps(invZ, iz);
+        for (int l = 0; l < RASTER_LANES; ++l) depth_test(t, px[l], py[l], invZ[l], s->ch[i + l]);
+    }
+    raster_samples_scalar(t, v, s, i, end);
+}
+
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_SIMD_NAME "SSE2"
+
+// two 4-wide halves per iteration
+static void raster_samples_simd(const RasterTarget* t, const RasterView* v, const CubeSamples* s,
+                                int begin, int end) {
+    const float (*m)[3] = v->rot.m;
+    const __m128 m00 = _mm_set1_ps(m[0][0]), m01 = _mm_set1_ps(m[0][1]), m02 = _mm_set1_ps(m[0][2]);
+    const __m128 m10 = _mm_set1_ps(m[1][0]), m11 = _mm_set1_ps(m[1][1]), m12 = _mm_set1_ps(m[1][2]);
+    const __m128 m20 = _mm_set1_ps(m[2][0]), m21 = _mm_set1_ps(m[2][1]), m22 = _mm_set1_ps(m[2][2]);
+    const __m128 dist = _mm_set1_ps(v->distance), k1 = _mm_set1_ps(v->k1);
+    const __m128 cx = _mm_set1_ps(v->centerX), cy = _mm_set1_ps(v->centerY);
+    const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+    int px[RASTER_LANES], py[RASTER_LANES];
+    float invZ[RASTER_LANES];
+    int i = begin;
+    for (; i + RASTER_LANES <= end; i += RASTER_LANES) {
+        for (int h = 0; h < RASTER_LANES; h += 4) {
+            __m128 x = _mm_loadu_ps(s->x + i + h), y = _mm_loadu_ps(s->y + i + h), z = _mm_loadu_ps(s->z + i + h);
+            __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z));
+            __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z));
+            __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z));
+            __m128 iz = _mm_div_ps(one, _mm_add_ps(rz, dist));
+            __m128 kz = _mm_mul_ps(k1, iz);
+            __m128 fx = _mm_add_ps(cx, _mm_mul_ps(_mm_mul_ps(kz, rx), two));
+            __m128 fy = _mm_add_ps(cy, _mm_mul_ps(kz, ry));
+            _mm_storeu_si128((__m128i*)(px + h), _mm_cvttps_epi32(fx));
+            _mm_storeu_si128((__m128i*)(py + h), _mm_cvttps_epi32(fy));
+            _mm_storeu_ps(invZ + h, iz);
+        }
+        for (int l = 0; l < RASTER_LANES; ++l) depth_test(t, px[l], py[l], invZ[l], s->ch[i + l]);
+    }
+    raster_samples_scalar(t, v, s, i, end);
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RASTER_SIMD_NAME "NEON"
+
+static inline float32x4_t neon_div(float32x4_t a, float32x4_t b) {
+#if defined(__aarch64__)
+    return vdivq_f32(a, b);
+#else
+    // ARMv7 has no vector divide; keep the result bit-identical to the scalar path
+    float fa[4], fb[4];
+    vst1q_f32(fa, a); vst1q_f32(fb, b);
+    for (int l = 0; l < 4; ++l) fa[l] /= fb[l];
+    return vld1q_f32(fa);
+#endif
+}
+
+// two 4-wide halves per iteration; explicit mul + add, no fused multiply-add
+static void raster_samples_simd(const RasterTarget* t, const RasterView* v, const CubeSamples* s,
+                                int begin, int end) {
+    const float (*m)[3] = v->rot.m;
+    const float32x4_t m00 = vdupq_n_f32(m[0][0]), m01 = vdupq_n_f32(m[0][1]), m02 = vdupq_n_f32(m[0][2]);
+    const float32x4_t m10 = vdupq_n_f32(m[1][0]), m11 = vdupq_n_f32(m[1][1]), m12 = vdupq_n_f32(m[1][2]);
+    const float32x4_t m20 = vdupq_n_f32(m[2][0]), m21 = vdupq_n_f32(m[2][1]), m22 = vdupq_n_f32(m[2][2]);
+    const float32x4_t dist = vdupq_n_f32(v->distance), k1 = vdupq_n_f32(v->k1);
+    const float32x4_t cx = vdupq_n_f32(v->centerX), cy = vdupq_n_f32(v->centerY);
+    const float32x4_t one = vdupq_n_f32(1.0f), two = vdupq_n_f32(2.0f);
+    int px[RASTER_LANES], py[RASTER_LANES];
+    float invZ[RASTER_LANES];
+    int i = begin;
+    for (; i + RASTER_LANES <= end; i += RASTER_LANES) {
+        for (int h = 0; h < RASTER_LANES; h += 4) {
+            float32x4_t x = vld1q_f32(s->x + i + h), y = vld1q_f32(s->y + i + h), z = vld1q_f32(s->z + i + h);
+            float32x4_t rx = vaddq_f32(vaddq_f32(vmulq_f32(m00, x), vmulq_f32(m01, y)), vmulq_f32(m02, z));
+            float32x4_t ry = vaddq_f32(vaddq_f32(vmulq_f32(m10, x), vmulq_f32(m11, y)), vmulq_f32(m12, z));
+            float32x4_t rz = vaddq_f32(vaddq_f32(vmulq_f32(m20, x), vmulq_f32(m21, y)), vmulq_f32(m22, z));
+            float32x4_t iz = neon_div(one, vaddq_f32(rz, dist));
+            float32x4_t kz = vmulq_f32(k1, iz);
+            float32x4_t fx = vaddq_f32(cx, vmulq_f32(vmulq_f32(kz, rx), two));
+            float32x4_t fy = vaddq_f32(cy, vmulq_f32(kz, ry));
+            vst1q_s32(px + h, vcvtq_s32_f32(fx));
+            vst1q_s32(py + h, vcvtq_s32_f32(fy));
+            vst1q_f32(invZ + h, iz);
+        }
+        for (int l = 0; l < RASTER_LANES; ++l) depth_test(t, px[l], py[l], invZ[l], s->ch[i + l]);
+    }
+    raster_samples_scalar(t, v, s, i, end);
+}
+
+#else
+#define RASTER_SIMD_NAME "scalar"
+#define raster_samples_simd raster_samples_scalar
+#endif
+
+const char* const rasterSimdName = RASTER_SIMD_NAME;
+
+void clear_raster_target(const RasterTarget* t) {
+    for (int i = 0; i < t->cols * t->rows; ++i) {
+        t->zbuf[i] = 0.0f;
+        t->chars[i] = backgroundASCIICode;
+    }
+}
+
+// Samples [begin, end) of the three cubes taken as one sequence, into t
+void raster_cube_range(const RasterTarget* t, long long begin, long long end, int useSimd) {
+    long long base = 0;
+    for (int c = 0; c < CUBE_COUNT && base < end; ++c) {
+        long long lo = begin > base ? begin : base;
+        long long hi = end < base + cubes[c].count ? end : base + cubes[c].count;
+        if (lo < hi) {
+            RasterView v = raster_view(t, &frameRot, cubes[c].offset * gridScale);
+            if (useSimd) raster_samples_simd(t, &v, &cubes[c], (int)(lo - base), (int)(hi - base));
+            else raster_samples_scalar(t, &v, &cubes[c], (int)(lo - base), (int)(hi - base));
+        }
+        base += cubes[c].count;
+    }
+}
+
+long long total_cube_samples(void) {
+    long long n = 0;
+    for (int c = 0; c < CUBE_COUNT; ++c) n += cubes[c].count;
+    return n;
+}
+
+// All three cubes into t with the current frameRot
+void raster_cubes(const RasterTarget* t, int useSimd) {
+    clear_raster_target(t);
+    raster_cube_range(t, 0, total_cube_samples(), useSimd);
+}
+
+// ========== Triangle meshes ==========
+// --obj FILE replaces the cubes with a mesh. Its vertices are rotated and projected
+// once per frame; triangles facing away are culled, the others are filled with edge
+// functions over the cells whose centers they cover (edges inclusive), with 1/z
+// interpolated across the triangle (it is affine in screen space) for the depth test,
+// and drawn with a luminance char from flat Lambert shading. The cost follows screen
+// coverage instead of surface area.
+
+ObjMesh sceneMesh;
+int meshLoaded = 0;
+static const float meshRadius = 30.0f; // normalized size, close to the big cube's
+// Dim to bright; every char needs a glyph in glyph_texture.c and a color in cell_color
+static const char lumRamp[] = ",-~:;=!*#$@";
+
+typedef struct {
+    float x, y, z;                     // rotated position
+    float sx, sy, ooz;                 // cell coordinates and 1/z
+} MeshVertex;
+static MeshVertex* meshVerts = NULL;
+
+int load_scene_mesh(const char* path) {
+    char err[256];
+    if (obj_mesh_load(&sceneMesh, path, err, sizeof(err)) != 0) {
+        fprintf(stderr, "%s\n", err);
+        return -1;
+    }
+    obj_mesh_normalize(&sceneMesh, meshRadius);
+    meshVerts = (MeshVertex*)malloc((size_t)sceneMesh.vertexCount * sizeof(MeshVertex));
+    if (!meshVerts) { obj_mesh_free(&sceneMesh); return -1; }
+    meshLoaded = 1;
+    fprintf(stderr, "%s: %d vertices, %d triangles\n", path, sceneMesh.vertexCount, sceneMesh.triangleCount);
+    return 0;
+}
+
+void free_scene_mesh(void) {
+    if (!meshLoaded) return;
+    obj_mesh_free(&sceneMesh);
+    free(meshVerts);
+    meshVerts = NULL;
+    meshLoaded = 0;
+}
+
+// Same projection as the point samples, mesh centered (no horizontal offset)
+void project_mesh(const RasterTarget* t) {
+    RasterView v = raster_view(t, &frameRot, 0.0f);
+    const float (*m)[3] = v.rot.m;
+    for (int i = 0; i < sceneMesh.vertexCount; ++i) {
+        const float* p = &sceneMesh.positions[i * 3];
+        MeshVertex* o = &meshVerts[i];
+        o->x = m[0][0] * p[0] + m[0][1] * p[1] + m[0][2] * p[2];
+        o->y = m[1][0] * p[0] + m[1][1] * p[1] + m[1][2] * p[2];
+        o->z = m[2][0] * p[0] + m[2][1] * p[1] + m[2][2] * p[2];
+        float z = o->z + v.distance;
+        o->ooz = z > 1e-3f ? 1.0f / z : 0.0f;
+        o->sx = v.centerX + v.k1 * o->ooz * o->x * 2.0f;
+        o->sy = v.centerY + v.k1 * o->ooz * o->y;
+    }
+}
+
+static void raster_triangle(const RasterTarget* t, const MeshVertex* a, const MeshVertex* b, const MeshVertex* c) {
+    if (a->ooz <= 0.0f || b->ooz <= 0.0f || c->ooz <= 0.0f) return;   // behind the camera
+    // back-face cull in view space (camera at the origin, CCW front faces)
+    float e1x = b->x - a->x, e1y = b->y - a->y, e1z = b->z - a->z;
+    float e2x = c->x - a->x, e2y = c->y - a->y, e2z = c->z - a->z;
+    float nx = e1y * e2z - e1z * e2y, ny = e1z * e2x - e1x * e2z, nz = e1x * e2y - e1y * e2x;
+    if (nx * a->x + ny * a->y + nz * (a->z + distanceFromCam) >= 0.0f) return;
+
+    float area = (b->sx - a->sx) * (c->sy - a->sy) - (b->sy - a->sy) * (c->sx - a->sx);
+    if (fabsf(area) < 1e-8f) return;
+    // light from the top of the screen (rows grow with y), toward the camera
+    float len = sqrtf(nx * nx + ny * ny + nz * nz);
+    float lum = len > 0.0f ? (-ny - nz) * 0.70710678f / len : 0.0f;
+    const int levels = (int)sizeof(lumRamp) - 1;
+    unsigned char ch = (unsigned char)lumRamp[lum <= 0.0f ? 0 : (int)(lum * (levels - 1) + 0.5f)];
+
+    float minX = fminf(a->sx, fminf(b->sx, c->sx)), maxX = fmaxf(a->sx, fmaxf(b->sx, c->sx));
+    float minY = fminf(a->sy, fminf(b->sy, c->sy)), maxY = fmaxf(a->sy, fmaxf(b->sy, c->sy));
+    int x0 = (int)floorf(minX - 0.5f), x1 = (int)ceilf(maxX - 0.5f);
+    int y0 = (int)floorf(minY - 0.5f), y1 = (int)ceilf(maxY - 0.5f);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > t->cols - 1) x1 = t->cols - 1;
+    if (y1 > t->rows - 1) y1 = t->rows - 1;
+    if (x0 > x1 || y0 > y1) return;
+
+    // edge functions, oriented so covered cells are >= 0, stepped per cell
+    const float sign = area > 0.0f ? 1.0f : -1.0f;
+    const float invArea = 1.0f / (area * sign);
+    const float ax = sign * (c->sy - b->sy), bx = sign * (a->sy - c->sy), cx = sign * (b->sy - a->sy);
+    const float ay = sign * (b->sx - c->sx), by = sign * (c->sx - a->sx), cy = sign * (a->sx - b->sx);
+    const float px0 = x0 + 0.5f, py0 = y0 + 0.5f;
+    float w0Row = sign * ((c->sx - b->sx) * (py0 - b->sy) - (c->sy - b->sy) * (px0 - b->sx));
+    float w1Row = sign * ((a->sx - c->sx) * (py0 - c->sy) - (a->sy - c->sy) * (px0 - c->sx));
+    float w2Row = sign * ((b->sx - a->sx) * (py0 - a->sy) - (b->sy - a->sy) * (px0 - a->sx));
+    for (int y = y0; y <= y1; ++y) {
+        float w0 = w0Row, w1 = w1Row, w2 = w2Row;
+        int idx = y * t->cols + x0;
+        for (int x = x0; x <= x1; ++x, ++idx) {
+            if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+                float ooz = (w0 * a->ooz + w1 * b->ooz + w2 * c->ooz) * invArea;
+                if (ooz > t->zbuf[idx]) {
+                    t->zbuf[idx] = ooz;
+                    t->chars[idx] = ch;
+                }
+            }
+            w0 -= ax; w1 -= bx; w2 -= cx;
+        }
+        w0Row -= ay; w1Row -= by; w2Row -= cy;
+    }
+}
+
+// Triangles [begin, end) of the mesh, projected by project_mesh, into t
+void raster_triangle_range(const RasterTarget* t, long long begin, long long end, int useSimd) {
+    (void)useSimd;
+    for (long long i = begin; i < end; ++i) {
+        const int* tri = &sceneMesh.indices[i * 3];
+        raster_triangle(t, &meshVerts[tri[0]], &meshVerts[tri[1]], &meshVerts[tri[2]]);
+    }
+}
+
+// ========== Threaded rasterization ==========
+// Worker w rasterizes the w-th contiguous slice of the sample (or triangle) sequence
+// into its own z/char buffers (worker 0 writes the final target directly). The slices
+// are merged in worker order with the same strict depth test, so a cell keeps the
+// first sample of greatest depth in sequence order: exactly what the serial loop
+// produces.
+
+WorkerPool* rasterPool = NULL;
+int rasterThreads = 0;                 // 0 = one per core
+static RasterTarget* workerTargets = NULL;
+
+typedef struct {
+    const RasterTarget* target;
+    long long total;
+    RasterRangeFn range;
+    int useSimd;
+} RasterJob;
+
+static void raster_worker(void* ctx, int worker, int workers) {
+    const RasterJob* job = (const RasterJob*)ctx;
+    const RasterTarget* t = worker == 0 ? job->target : &workerTargets[worker];
+    long long begin = job->total * worker / workers;
+    long long end = job->total * (worker + 1) / workers;
+    clear_raster_target(t);
+    job->range(t, begin, end, job->useSimd);
+}
+
+// Worker targets get their buffers from resize_worker_targets
+int init_raster_pool(void) {
+    rasterPool = worker_pool_create(rasterThreads);
+    if (!rasterPool) return -1;
+    workerTargets = (RasterTarget*)calloc(worker_pool_size(rasterPool), sizeof(RasterTarget));
+    return workerTargets ? 0 : -1;
+}
+
+static void free_worker_targets(void) {
+    int workers = worker_pool_size(rasterPool);
+    for (int w = 1; w < workers; ++w) {
+        free_aligned(workerTargets[w].zbuf);
+        free_aligned(workerTargets[w].chars);
+        memset(&workerTargets[w], 0, sizeof(RasterTarget));
+    }
+}
+
+static int resize_worker_targets(void) {
+    free_worker_targets();
+    int workers = worker_pool_size(rasterPool);
+    const size_t cells = (size_t)width_chars * height_chars;
+    for (int w = 1; w < workers; ++w) {
+        workerTargets[w].cols = width_chars;
+        workerTargets[w].rows = height_chars;
+        workerTargets[w].zbuf = (float*)alloc_aligned(cells * sizeof(float));
+        workerTargets[w].chars = (unsigned char*)alloc_aligned(cells);
+        if (!workerTargets[w].zbuf || !workerTargets[w].chars) return -1;
+    }
+    return 0;
+}
+
+void free_raster_pool(void) {
+    if (workerTargets) {
+        free_worker_targets();
+        free(workerTargets);
+        workerTargets = NULL;
+    }
+    worker_pool_destroy(rasterPool);
+    rasterPool = NULL;
+}
+
+static void raster_threaded(const RasterTarget* t, long long total, RasterRangeFn range, int useSimd) {
+    int workers = worker_pool_size(rasterPool);
+    if (workers <= 1) {
+        clear_raster_target(t);
+        range(t, 0, total, useSimd);
+        return;
+    }
+    RasterJob job = { t, total, range, useSimd };
+    worker_pool_run(rasterPool, raster_worker, &job);
+    const int cells = t->cols * t->rows;
+    for (int w = 1; w < workers; ++w) {
+        const RasterTarget* src = &workerTargets[w];
+        for (int i = 0; i < cells; ++i) {
+            if (src->zbuf[i] > t->zbuf[i]) {
+                t->zbuf[i] = src->zbuf[i];
+                t->chars[i] = src->chars[i];
+            }
+        }
+    }
+}
+
+// Fill buffers just like original example (three cubes), or with the --obj mesh
+void render_ascii_cubes_to_buffer(void) {
+    RasterTarget t = { zBuffer, charBuffer, width_chars, height_chars };
+    begin_frame_transform();
+    if (meshLoaded) {
+        project_mesh(&t);
+        raster_threaded(&t, sceneMesh.triangleCount, raster_triangle_range, 1);
+    } else {
+        raster_threaded(&t, total_cube_samples(), raster_cube_range, 1);
+    }
+}
+
+// ========== Grid size ==========
+// The scene scales with the grid (gridScale = 1 at DEFAULT_COLS x DEFAULT_ROWS): K1 and
+// the cube offsets grow with it and the sample step shrinks with it, so the cubes keep
+// their place in the frame, and the samples per frame grow with the cell count. On
+// grids larger than the default the samples snap to a 1/gridScale lattice instead of
+// integers: integer samples would stay ~2*width positions across a face while K1
+// spreads them over gridScale times more cells, leaving gaps the back faces show
+// through. Up to the default grid the lattice is sampleLattice (integers by default,
+// as in the original). Denser sampling takes a finer lattice as well as a smaller
+// step: on a fixed lattice a smaller step only finds the same points again.
+
+void raster_free_grid(void) {
+    free_aligned(zBuffer);
+    free_aligned(charBuffer);
+    zBuffer = NULL;
+    charBuffer = NULL;
+}
+
+int raster_resize_grid(int cols, int rows) {
+    if (cols < 8) cols = 8;
+    if (rows < 4) rows = 4;
+    raster_free_grid();
+    const size_t cells = (size_t)cols * rows;
+    zBuffer = (float*)alloc_aligned(cells * sizeof(float));
+    charBuffer = (unsigned char*)alloc_aligned(cells);
+    if (!zBuffer || !charBuffer) return -1;
+    width_chars = cols;
+    height_chars = rows;
+
+    float sx = (float)cols / DEFAULT_COLS, sy = (float)rows / DEFAULT_ROWS;
+    gridScale = sx < sy ? sx : sy;
+    K1 = 40.0f * gridScale;
+    float step = baseStep / gridScale;
+    if (step < 0.01f) step = 0.01f;
+    float quantum = gridScale > 1.0f ? sampleLattice / gridScale : sampleLattice;
+    if (quantum < 0.01f) quantum = 0.01f;
+    if (step != incrementSpeed || quantum != sampleQuantum || !cubes[0].x) {
+        incrementSpeed = step;
+        sampleQuantum = quantum;
+        if (init_cube_samples() != 0) return -1;
+    }
+    if (resize_worker_targets() != 0) return -1;
+
+    RasterTarget t = { zBuffer, charBuffer, width_chars, height_chars };
+    clear_raster_target(&t);
+    return 0;
+}
@@ -0,0 +1,75 @@
+// ascii_raster.h
+// CPU side of the ASCII cubes (no GL / GLFW dependency): the char grid and its depth
+// buffer, the cube samples, the scalar and SIMD raster kernels, OBJ triangles and the
+// threaded raster on a worker pool. render_ascii_cubes_to_buffer() fills charBuffer
+// and zBuffer for the angles in A, B, C.
+#ifndef ASCII_RASTER_H
+#define ASCII_RASTER_H
+
+#include "obj_mesh.h"
+#include "worker_pool.h"
+
+#include <stddef.h>
+
+// Terminal-like resolution the scene was laid out for; the grid itself is sized at
+// run time, see raster_resize_grid
+#define DEFAULT_COLS 160
+#define DEFAULT_ROWS 44
+
+typedef struct {
+    float* zbuf;
+    unsigned char* chars;
+    int cols, rows;
+} RasterTarget;
+
+typedef void (*RasterRangeFn)(const RasterTarget* t, long long begin, long long end, int useSimd);
+
+extern float* zBuffer;                 // width_chars x height_chars, 1/z per cell
+extern unsigned char* charBuffer;      // ASCII code per cell
+extern const unsigned char backgroundASCIICode;
+extern float A, B, C;                  // rotation angles
+extern int width_chars, height_chars;
+extern float incrementSpeed;           // sample spacing on the faces at the current grid size
+extern float baseStep;                 // sample spacing at the default grid size (set before resizing)
+extern float sampleLattice;            // lattice the samples snap to at the default grid size: 1 is the
+                                       // original integer truncation, smaller values sample between
+                                       // integers (set before resizing)
+extern float gridScale;
+extern const char* const rasterSimdName;
+extern WorkerPool* rasterPool;
+extern int rasterThreads;              // pool size for init_raster_pool, 0 = one per core
+extern ObjMesh sceneMesh;
+extern int meshLoaded;
+
+// Cache-line aligned blocks padded to whole lines
+void* alloc_aligned(size_t bytes);
+void free_aligned(void* p);
+
+int init_raster_pool(void);
+void free_raster_pool(void);
+// Reallocates zBuffer / charBuffer (and the per-worker buffers) for cols x rows, rescales
+// the scene to the grid and clears it; 0 on success
+int raster_resize_grid(int cols, int rows);
+void raster_free_grid(void);
+void free_cube_samples(void);
+// Replaces the cubes with the mesh in path, normalized to the big cube's size
+int load_scene_mesh(const char* path);
+void free_scene_mesh(void);
+
+// Reference path: the original per-sample trig, straight into charBuffer
+void render_ascii_cubes_reference(void);
+// Rotation for the current A, B, C; call before the range functions
+void begin_frame_transform(void);
+void clear_raster_target(const RasterTarget* t);
+// Samples [begin, end) of the three cubes taken as one sequence, into t
+void raster_cube_range(const RasterTarget* t, long long begin, long long end, int useSimd);
+long long total_cube_samples(void);
+// All three cubes into t, on the calling thread
+void raster_cubes(const RasterTarget* t, int useSimd);
+// Mesh vertices for the current rotation, then triangles [begin, end) into t
+void project_mesh(const RasterTarget* t);
+void raster_triangle_range(const RasterTarget* t, long long begin, long long end, int useSimd);
+// The cubes (or the mesh) into charBuffer / zBuffer on the raster pool
+void render_ascii_cubes_to_buffer(void);
+
+#endif
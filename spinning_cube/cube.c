@@ -2,174 +2,114 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
-#include <math.h>
+#include "ascii_raster.h"
+#include "frame_pacing.h"
+#include "glyph_texture.h"
+#include "terminal_out.h"
+#include "worker_pool.h"
+
+#include <signal.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <time.h>
-
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
-// Terminal-like resolution
-#define CHAR_COLS 160
-#define CHAR_ROWS 44
-
-// Font glyph size (pixels)
-#define GLYPH_W 8
-#define GLYPH_H 8
-
-// Window pixel size (texture will be CHAR_COLS*GLYPH_W x CHAR_ROWS*GLYPH_H)
-const int WIN_W = CHAR_COLS * GLYPH_W; // 1280
-const int WIN_H = CHAR_ROWS * GLYPH_H; // 352
-
-// ASCII buffer & z-buffer
-static float zBuffer[CHAR_COLS * CHAR_ROWS];
-static unsigned char charBuffer[CHAR_COLS * CHAR_ROWS]; // stores ASCII code
-static const unsigned char backgroundASCIICode = '.';
-
-// Cubes parameters (kept from original)
-static float A = 0.0f, B = 0.0f, C = 0.0f;
-static float cubeWidth = 20.0f;
-static int width_chars = CHAR_COLS;
-static int height_chars = CHAR_ROWS;
-static float distanceFromCam = 100.0f;
-static float horizontalOffset = 0.0f;
-static float K1 = 40.0f;
-static float incrementSpeed = 0.6f;
-
-// Temp per-surface
-static float x_, y_, z_;
-static float ooz;
-static int xp, yp;
-static int idx_;
-
-// Simple helper to sleep milliseconds (cross-platform)
-static void sleep_ms(int ms) {
-#ifdef _WIN32
-    Sleep(ms);
-#else
-    struct timespec req = { ms / 1000, (ms % 1000) * 1000000 };
-    nanosleep(&req, NULL);
-#endif
-}
 
-// ========== Small 8x8 bitmap font for the chars we use =========
-// Each glyph is 8 bytes (rows), LSB is leftmost pixel. 1 => pixel on.
-typedef unsigned char GlyphRow;
-typedef struct { char ch; GlyphRow rows[GLYPH_H]; } GlyphEntry;
-
-// We only need glyphs for: '@', '$', '~', '#', ';', '+', '.' and space.
-// Glyph patterns are simple approximations (not full font).
-static GlyphEntry glyphs[] = {
-    // '@' approximate
-    {'@', {0x3C,0x42,0x9D,0x9D,0x9B,0x40,0x3C,0x00}},
-    // '$' approximate
-    {'$', {0x08,0x3E,0x28,0x3C,0x0A,0x3E,0x08,0x00}},
-    // '~' approximate (wavy)
-    {'~', {0x00,0x00,0x18,0x24,0x12,0x00,0x00,0x00}},
-    // '#' hash
-    {'#', {0x00,0x24,0x7E,0x24,0x7E,0x24,0x00,0x00}},
-    // ';' semicolon (dot + short vertical)
-    {';', {0x00,0x00,0x18,0x18,0x18,0x10,0x10,0x08}},
-    // '+' plus
-    {'+', {0x00,0x08,0x08,0x3E,0x08,0x08,0x00,0x00}},
-    // '.' dot
-    {'.', {0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00}},
-    // ' ' space
-    {' ', {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}},
-};
-
-// Find glyph by char (linear search small table)
-static const GlyphRow* find_glyph(char c) {
-    for (size_t i = 0; i < sizeof(glyphs)/sizeof(glyphs[0]); ++i) {
-        if (glyphs[i].ch == c) return glyphs[i].rows;
-    }
-    return NULL;
+static int gridCols = 0, gridRows = 0; // --cols / --rows (0 = follow the window / terminal)
+static double simHz = 60.0;            // --sim-hz: animation steps per second
+static int pipelined = 0;              // --pipeline: rasterize the next frame while this one is shown
+static const char* objPath = NULL;     // --obj
+static int cpuGlyphs = 0;              // --cpu-glyphs: expand glyphs on the CPU (RGBA texture)
+static int terminalMode = 0;           // --terminal: draw to stdout with ANSI sequences, no window / GL
+static int terminalColor = 0;          // --color: 24-bit colors in terminal mode
+static int runFrames = 0;              // --frames N: stop after N frames (0 = run until closed)
+
+// Frame pacing (command line: --swap N, --fps F, --latency-csv PATH)
+static int swapInterval = 0;
+static double fpsCap = 60.0;           // 0 = uncapped
+static const char* latencyCsv = NULL;
+static FramePacer framePacer;
+static FrameLog frameLog;
+
+// Mouse motion is the latency probe: the next swap is the first that could reflect it
+static void cursor_pos_cb(GLFWwindow* w, double x, double y) {
+    (void)w; (void)x; (void)y;
+    frame_log_input(&frameLog, pacing_now());
 }
 
-// ========== Soft ASCII projection math (copied from original) ==========
-static float calculateX(int i, int j, int k) {
-    return j * sinf(A) * sinf(B) * cosf(C) - k * cosf(A) * sinf(B) * cosf(C) +
-           j * cosf(A) * sinf(C) + k * sinf(A) * sinf(C) + i * cosf(B) * cosf(C);
+// ========== Animation clock ==========
+// The angles advance in fixed steps of 1/simHz seconds (one step is the original
+// per-frame increment, so 60 steps/s keeps the original speed at 60 FPS), however
+// fast frames come. A frame renders the state interpolated between the last two
+// steps by the fraction of a step left in the accumulator.
+typedef struct { float a, b, c; } CubeAngles;
+
+typedef struct {
+    CubeAngles prev, cur;
+    double step, accumulator, last;
+} SimClock;
+
+static void sim_step(CubeAngles* s) {
+    s->a += 0.05f;
+    s->b += 0.05f;
+    s->c += 0.01f;
 }
 
-static float calculateY(int i, int j, int k) {
-    return j * cosf(A) * cosf(C) + k * sinf(A) * cosf(C) -
-           j * sinf(A) * sinf(B) * sinf(C) + k * cosf(A) * sinf(B) * sinf(C) -
-           i * cosf(B) * sinf(C);
+static void sim_clock_init(SimClock* c, double now) {
+    c->cur.a = A; c->cur.b = B; c->cur.c = C;
+    c->prev = c->cur;
+    c->step = 1.0 / (simHz > 0.0 ? simHz : 60.0);
+    c->accumulator = 0.0;
+    c->last = now;
 }
 
-static float calculateZ(int i, int j, int k) {
-    return k * cosf(A) * cosf(B) - j * sinf(A) * cosf(B) + i * sinf(B);
-}
-
-static void calculateForSurface(float cubeX, float cubeY, float cubeZ, int ch) {
-    x_ = calculateX((int)cubeX, (int)cubeY, (int)cubeZ);
-    y_ = calculateY((int)cubeX, (int)cubeY, (int)cubeZ);
-    z_ = calculateZ((int)cubeX, (int)cubeY, (int)cubeZ) + distanceFromCam;
-
-    ooz = 1.0f / z_;
-
-    xp = (int)(width_chars / 2 + horizontalOffset + K1 * ooz * x_ * 2.0f);
-    yp = (int)(height_chars / 2 + K1 * ooz * y_);
-
-    idx_ = xp + yp * width_chars;
-    if (idx_ >= 0 && idx_ < width_chars * height_chars) {
-        if (ooz > zBuffer[idx_]) {
-            zBuffer[idx_] = ooz;
-            charBuffer[idx_] = (unsigned char)ch;
-        }
+// Runs the steps due by now, then sets A, B, C to the interpolated state
+static void sim_clock_advance(SimClock* c, double now) {
+    double dt = now - c->last;
+    c->last = now;
+    if (dt > 0.25) dt = 0.25;        // after a stall (window drag, breakpoint) do not fast-forward
+    c->accumulator += dt;
+    while (c->accumulator >= c->step) {
+        c->prev = c->cur;
+        sim_step(&c->cur);
+        c->accumulator -= c->step;
     }
+    float t = (float)(c->accumulator / c->step);
+    A = c->prev.a + (c->cur.a - c->prev.a) * t;
+    B = c->prev.b + (c->cur.b - c->prev.b) * t;
+    C = c->prev.c + (c->cur.c - c->prev.c) * t;
 }
 
-// Fill buffers just like original example (three cubes)
-static void render_ascii_cubes_to_buffer() {
-    // clear
-    for (int i = 0; i < width_chars * height_chars; ++i) {
-        zBuffer[i] = 0.0f;
-        charBuffer[i] = backgroundASCIICode;
-    }
-
-    cubeWidth = 20.0f;
-    horizontalOffset = -2.0f * cubeWidth;
-    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
-        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
-            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
-            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
-            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
-            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
-            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
-            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
-        }
-    }
-
-    cubeWidth = 10.0f;
-    horizontalOffset = 1.0f * cubeWidth;
-    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
-        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
-            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
-            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
-            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
-            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
-            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
-            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
-        }
+// ========== Pipelined frames ==========
+// --pipeline: while the main thread uploads and presents the finished frame (held in
+// presentChars), a second thread rasterizes the next one into charBuffer with the
+// raster pool. Both run as one two-worker pool run, so a frame costs
+// max(raster, present) instead of their sum, at the price of one frame of latency.
+// The stages share no buffers; resizes happen between runs.
+
+static WorkerPool* pipePool = NULL;
+static unsigned char* presentChars = NULL;   // sized with the grid (resize_char_grid)
+
+typedef struct {
+    void (*present)(void* ctx);      // worker 0, the thread that owns the GL context / stdout
+    void* presentCtx;
+    void (*rendered)(void* ctx);     // optional, on the raster thread after the raster
+    void* renderedCtx;
+} PipelineJob;
+
+static void pipeline_worker(void* ctx, int worker, int workers) {
+    const PipelineJob* job = (const PipelineJob*)ctx;
+    if (worker == 0) job->present(job->presentCtx);
+    if (worker == 1 || workers == 1) {
+        render_ascii_cubes_to_buffer();
+        if (job->rendered) job->rendered(job->renderedCtx);
     }
+}
 
-    cubeWidth = 5.0f;
-    horizontalOffset = 8.0f * cubeWidth;
-    for (float cubeX = -cubeWidth; cubeX < cubeWidth; cubeX += incrementSpeed) {
-        for (float cubeY = -cubeWidth; cubeY < cubeWidth; cubeY += incrementSpeed) {
-            calculateForSurface(cubeX, cubeY, -cubeWidth, '@');
-            calculateForSurface(cubeWidth, cubeY, cubeX, '$');
-            calculateForSurface(-cubeWidth, cubeY, -cubeX, '~');
-            calculateForSurface(-cubeX, cubeY, cubeWidth, '#');
-            calculateForSurface(cubeX, -cubeWidth, -cubeY, ';');
-            calculateForSurface(cubeX, cubeWidth, cubeY, '+');
-        }
-    }
+// The frame rasterized by the last run becomes the one to present
+static void swap_frame_chars(void) {
+    unsigned char* t = charBuffer;
+    charBuffer = presentChars;
+    presentChars = t;
 }
 
 // ========== GL shader sources (simple textured quad) ==========
@@ -187,6 +127,26 @@ static const char* fs_src =
 "uniform sampler2D uTex;\n" 
 "void main(){ FragColor = texture(uTex, vUV); }\n";
 
+// GPU glyph expansion: one char code per cell in an R8UI texture, glyph pixels from an
+// atlas of 16x16 glyphs (R8, built once). Same texel mapping as the RGBA texture above.
+#define CUBE_STR_(x) #x
+#define CUBE_STR(x) CUBE_STR_(x)
+static const char* fs_cells_src =
+"#version 330 core\n"
+"in vec2 vUV;\n"
+"out vec4 FragColor;\n"
+"uniform usampler2D uChars;\n"
+"uniform sampler2D uAtlas;\n"
+"const ivec2 GLYPH = ivec2(" CUBE_STR(GLYPH_W) ", " CUBE_STR(GLYPH_H) ");\n"
+"void main(){\n"
+"    ivec2 cells = textureSize(uChars, 0);\n"
+"    ivec2 texel = clamp(ivec2(vUV * vec2(cells * GLYPH)), ivec2(0), cells * GLYPH - 1);\n"
+"    uint ch = texelFetch(uChars, texel / GLYPH, 0).r;\n"
+"    ivec2 glyphOrigin = ivec2(int(ch % 16u), int(ch / 16u)) * GLYPH;\n"
+"    float on = texelFetch(uAtlas, glyphOrigin + texel % GLYPH, 0).r;\n"
+"    FragColor = vec4(vec3(on), 1.0);\n"
+"}\n";
+
 // Helper to compile shader
 static GLuint compile_shader(GLenum type, const char* src) {
     GLuint s = glCreateShader(type);
@@ -222,68 +182,580 @@ static GLuint link_program(GLuint vs, GLuint fs) {
     return p;
 }
 
-// Create an RGBA pixel buffer for the whole texture (WIN_W x WIN_H)
-static unsigned char* texPixels = NULL;
-
-// Fill texPixels using charBuffer and glyphs (white glyph on black bg)
-static void build_texture_from_charbuffer() {
-    int texW = CHAR_COLS * GLYPH_W;
-    int texH = CHAR_ROWS * GLYPH_H;
-    // fill black
-    memset(texPixels, 0, texW * texH * 4);
-
-    for (int cy = 0; cy < CHAR_ROWS; ++cy) {
-        for (int cx = 0; cx < CHAR_COLS; ++cx) {
-            unsigned char ch = charBuffer[cx + cy * CHAR_COLS];
-            const GlyphRow* g = find_glyph((char)ch);
-            if (!g) g = find_glyph(' '); // fallback
-            // top-left pixel of this glyph in texture
-            int px = cx * GLYPH_W;
-            int py = cy * GLYPH_H;
-            for (int gy = 0; gy < GLYPH_H; ++gy) {
-                GlyphRow row = g[gy];
-                for (int gx = 0; gx < GLYPH_W; ++gx) {
-                    int bit = (row >> (7 - gx)) & 1;
-                    int tx = px + gx;
-                    int ty = py + gy;
-                    int tidx = (ty * texW + tx) * 4;
-                    if (bit) {
-                        // white opaque pixel (you can change color here)
-                        texPixels[tidx + 0] = 255;
-                        texPixels[tidx + 1] = 255;
-                        texPixels[tidx + 2] = 255;
-                        texPixels[tidx + 3] = 255;
-                    } else {
-                        // leave transparent / black
-                        texPixels[tidx + 0] = 0;
-                        texPixels[tidx + 1] = 0;
-                        texPixels[tidx + 2] = 0;
-                        texPixels[tidx + 3] = 255; // opaque black background
-                    }
-                }
+// Two pixel-unpack buffers used in turn and orphaned before each write, so filling
+// one never waits for the GPU to finish reading the other.
+typedef struct {
+    GLuint pbo[2];
+    int next;
+    size_t capacity;
+    unsigned long long frames, uploadedBytes, changedCells;
+} TextureUploader;
+
+static void texture_uploader_init(TextureUploader* u, size_t capacity) {
+    memset(u, 0, sizeof(*u));
+    u->capacity = capacity;
+    glGenBuffers(2, u->pbo);
+}
+
+static void texture_uploader_free(TextureUploader* u) {
+    glDeleteBuffers(2, u->pbo);
+}
+
+// Uploads the spans of d (diffed from chars) into tex; scratch (>= d->bytes) is used if
+// the PBO cannot be mapped
+static void upload_dirty_spans(TextureUploader* u, GLuint tex, const unsigned char* chars, const DirtySpans* d,
+                               unsigned char* scratch) {
+    u->frames++;
+    u->uploadedBytes += d->bytes;
+    u->changedCells += d->cells;
+    if (d->count == 0) return;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, u->pbo[u->next]);
+    u->next ^= 1;
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)u->capacity, NULL, GL_STREAM_DRAW);
+    unsigned char* mapped = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)d->bytes,
+                                                             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    int fromPbo = 0;
+    if (mapped) {
+        write_dirty_spans(mapped, chars, d);
+        fromPbo = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+    if (!fromPbo) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        write_dirty_spans(scratch, chars, d);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, tex);
+    for (int k = 0; k < d->count; ++k) {
+        const void* src = fromPbo ? (const void*)(uintptr_t)d->offset[k] : (const void*)(scratch + d->offset[k]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, d->colBegin[k] * GLYPH_W, d->row[k] * GLYPH_H,
+                        (d->colEnd[k] - d->colBegin[k]) * GLYPH_W, GLYPH_H, GL_RGBA, GL_UNSIGNED_BYTE, src);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+// ========== Grid size ==========
+// The window and terminal backends call resize_char_grid whenever their size in cells
+// changes; the scene rescales with the grid (see raster_resize_grid).
+
+static void free_char_grid(void) {
+    raster_free_grid();
+    glyph_free_grid();
+    free_aligned(presentChars);
+    presentChars = NULL;
+}
+
+// Reallocates every per-cell buffer for cols x rows and clears it to the background
+// (prevChars too: whatever shows the grid must start from a cleared texture / screen)
+static int resize_char_grid(int cols, int rows) {
+    free_aligned(presentChars);
+    presentChars = NULL;
+    if (raster_resize_grid(cols, rows) != 0 || glyph_resize_grid() != 0) return -1;
+    const size_t cells = (size_t)width_chars * height_chars;
+    presentChars = (unsigned char*)alloc_aligned(cells);
+    if (!presentChars) return -1;
+    memcpy(presentChars, charBuffer, cells);
+    return 0;
+}
+
+// Textures showing the grid: char codes (GPU glyphs) and, for --cpu-glyphs or the
+// sweep, the RGBA glyph texture with its CPU copy in texPixels
+typedef struct {
+    GLuint tex, charTex;
+    int rgba;                        // tex is in use
+    TextureUploader uploader;
+} GridTextures;
+
+// Respecifies the textures at the current grid size, with the cleared charBuffer
+static int resize_grid_textures(GridTextures* g) {
+    if (g->rgba) {
+        const size_t texBytes = (size_t)width_chars * GLYPH_W * height_chars * GLYPH_H * 4;
+        unsigned char* px = (unsigned char*)realloc(texPixels, texBytes);
+        if (!px) return -1;
+        texPixels = px;
+        build_texture_from_charbuffer();
+        g->uploader.capacity = texBytes;
+        glBindTexture(GL_TEXTURE_2D, g->tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width_chars * GLYPH_W, height_chars * GLYPH_H, 0, GL_RGBA,
+                     GL_UNSIGNED_BYTE, texPixels);
+    }
+    glBindTexture(GL_TEXTURE_2D, g->charTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8UI, width_chars, height_chars, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE, charBuffer);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return 0;
+}
+
+static void shutdown_renderer(void) {
+    free(texPixels);
+    texPixels = NULL;
+    free_scene_mesh();
+    free_raster_pool();
+    worker_pool_destroy(pipePool);
+    pipePool = NULL;
+    free_cube_samples();
+    free_char_grid();
+}
+
+// --bench N: N frames of the reference path, the scalar kernel and the SIMD kernel on
+// the same angles, without a window. Reports ms/frame, samples/s, and how many cells
+// differ from the reference (the matrix sums the same terms in a different order, so
+// a few edge samples can round the other way; scalar, SIMD and threaded must agree
+// exactly). Then times both texture builds on each frame's chars; those must match
+// byte for byte.
+static int run_mesh_bench(int frames) {
+    RasterTarget t = { zBuffer, charBuffer, width_chars, height_chars };
+    double tSerial = 0.0, tThreads = 0.0;
+    long long covered = 0;
+    for (int f = 0; f < frames; ++f) {
+        double t0 = pacing_now();
+        begin_frame_transform();
+        project_mesh(&t);
+        clear_raster_target(&t);
+        raster_triangle_range(&t, 0, sceneMesh.triangleCount, 0);
+        double t1 = pacing_now();
+        render_ascii_cubes_to_buffer();
+        double t2 = pacing_now();
+        tSerial += t1 - t0;
+        tThreads += t2 - t1;
+        for (int i = 0; i < width_chars * height_chars; ++i) covered += charBuffer[i] != backgroundASCIICode;
+        A += 0.05f;
+        B += 0.05f;
+        C += 0.01f;
+    }
+    printf("mesh %s, %d frames, %d triangles, %.0f covered cells/frame\n",
+           objPath, frames, sceneMesh.triangleCount, (double)covered / frames);
+    printf("  serial:          %8.3f ms/frame  %7.2f Mtriangles/s\n", tSerial * 1e3 / frames,
+           sceneMesh.triangleCount * (double)frames / tSerial * 1e-6);
+    printf("  %2d threads:      %8.3f ms/frame\n", worker_pool_size(rasterPool), tThreads * 1e3 / frames);
+    return 0;
+}
+
+static int run_bench(int frames) {
+    if (meshLoaded) return run_mesh_bench(frames);
+    const size_t cells = (size_t)width_chars * height_chars;
+    const size_t texBytes = cells * GLYPH_W * GLYPH_H * 4;
+    unsigned char* refChars = (unsigned char*)malloc(cells * 3);
+    unsigned char* refTex = (unsigned char*)malloc(texBytes);
+    unsigned char* tileTex = (unsigned char*)malloc(texBytes);
+    unsigned char* packed = (unsigned char*)malloc(texBytes);
+    unsigned char* patchedTex = (unsigned char*)malloc(texBytes);
+    if (!refChars || !refTex || !tileTex || !packed || !patchedTex) {
+        free(refChars); free(refTex); free(tileTex); free(packed); free(patchedTex);
+        return -1;
+    }
+    unsigned char* scalarChars = refChars + cells;
+    unsigned char* simdChars = scalarChars + cells;
+    double tTexRef = 0.0, tTexTiles = 0.0, tTexDirty = 0.0;
+    long long diffTex = 0, diffPatched = 0;
+    unsigned long long dirtyBytes = 0, dirtyCells = 0;
+    // the patched texture starts from the background, like the window
+    memset(charBuffer, backgroundASCIICode, cells);
+    memcpy(prevChars, charBuffer, cells);
+    build_texture_into(patchedTex);
+    RasterTarget t = { zBuffer, charBuffer, width_chars, height_chars };
+    double tRef = 0.0, tScalar = 0.0, tSimd = 0.0, tThreads = 0.0;
+    long long diffRef = 0, diffSimd = 0, diffThreads = 0;
+    for (int f = 0; f < frames; ++f) {
+        double t0 = pacing_now();
+        render_ascii_cubes_reference();
+        double t1 = pacing_now();
+        memcpy(refChars, charBuffer, cells);
+        begin_frame_transform();
+        raster_cubes(&t, 0);
+        double t2 = pacing_now();
+        memcpy(scalarChars, charBuffer, cells);
+        begin_frame_transform();
+        raster_cubes(&t, 1);
+        double t3 = pacing_now();
+        memcpy(simdChars, charBuffer, cells);
+        render_ascii_cubes_to_buffer();
+        double t4 = pacing_now();
+        tRef += t1 - t0;
+        tScalar += t2 - t1;
+        tSimd += t3 - t2;
+        tThreads += t4 - t3;
+
+        double t5 = pacing_now();
+        build_texture_reference(refTex);
+        double t6 = pacing_now();
+        build_texture_into(tileTex);
+        double t7 = pacing_now();
+        tTexRef += t6 - t5;
+        tTexTiles += t7 - t6;
+        diffTex += memcmp(refTex, tileTex, texBytes) != 0;
+
+        // dirty spans, then patch them into the previous frame's texture like the
+        // glTexSubImage2D calls would
+        const DirtySpans* dirty = &dirtySpans;
+        double t8 = pacing_now();
+        diff_char_rows(prevChars, charBuffer, &dirtySpans);
+        write_dirty_spans(packed, charBuffer, dirty);
+        double t9 = pacing_now();
+        tTexDirty += t9 - t8;
+        dirtyBytes += dirty->bytes;
+        dirtyCells += dirty->cells;
+        for (int k = 0; k < dirty->count; ++k) {
+            const size_t spanRow = (size_t)(dirty->colEnd[k] - dirty->colBegin[k]) * GLYPH_ROW_BYTES;
+            for (int gy = 0; gy < GLYPH_H; ++gy)
+                memcpy(patchedTex + ((size_t)(dirty->row[k] * GLYPH_H + gy) * width_chars + dirty->colBegin[k]) * GLYPH_ROW_BYTES,
+                       packed + dirty->offset[k] + gy * spanRow, spanRow);
+        }
+        diffPatched += memcmp(patchedTex, tileTex, texBytes) != 0;
+        for (size_t i = 0; i < cells; ++i) {
+            diffRef += refChars[i] != scalarChars[i];
+            diffSimd += scalarChars[i] != simdChars[i];
+            diffThreads += simdChars[i] != charBuffer[i];
+        }
+        A += 0.05f;
+        B += 0.05f;
+        C += 0.01f;
+    }
+    long long samples = total_cube_samples();
+    printf("render_ascii_cubes_to_buffer, %dx%d cells, %d frames, %lld samples/frame (step %g, lattice %g)\n",
+           width_chars, height_chars, frames, samples, incrementSpeed, sampleLattice);
+    printf("  per-sample trig: %8.3f ms/frame  %7.1f Msamples/s\n", tRef * 1e3 / frames, samples * frames / tRef * 1e-6);
+    printf("  scalar kernel:   %8.3f ms/frame  %7.1f Msamples/s\n", tScalar * 1e3 / frames, samples * frames / tScalar * 1e-6);
+    printf("  %-6s kernel:   %8.3f ms/frame  %7.1f Msamples/s\n", rasterSimdName, tSimd * 1e3 / frames, samples * frames / tSimd * 1e-6);
+    printf("  %2d threads:      %8.3f ms/frame  %7.1f Msamples/s\n", worker_pool_size(rasterPool), tThreads * 1e3 / frames, samples * frames / tThreads * 1e-6);
+    printf("  cells differing from the reference: %lld of %lld\n", diffRef, (long long)frames * (long long)cells);
+    printf("  cells differing scalar vs %s: %lld\n", rasterSimdName, diffSimd);
+    printf("  cells differing serial vs threaded: %lld\n", diffThreads);
+    printf("build_texture_from_charbuffer, %dx%d RGBA\n", width_chars * GLYPH_W, height_chars * GLYPH_H);
+    printf("  per-bit writes:  %8.3f ms/frame\n", tTexRef * 1e3 / frames);
+    printf("  glyph tiles:     %8.3f ms/frame  (%.1fx, %d threads)\n", tTexTiles * 1e3 / frames,
+           tTexTiles > 0.0 ? tTexRef / tTexTiles : 0.0, worker_pool_size(rasterPool));
+    printf("  dirty spans:     %8.3f ms/frame  (diff + changed tiles)\n", tTexDirty * 1e3 / frames);
+    printf("  upload: %.1f KB/frame of %.1f KB full, %.0f changed cells/frame\n",
+           dirtyBytes / 1024.0 / frames, texBytes / 1024.0, (double)dirtyCells / frames);
+    printf("  frames with a differing texture: %lld tiles, %lld patched\n", diffTex, diffPatched);
+    free(refChars);
+    free(refTex);
+    free(tileTex);
+    free(packed);
+    free(patchedTex);
+    return (diffSimd == 0 && diffThreads == 0 && diffTex == 0 && diffPatched == 0) ? 0 : 1;
+}
+
+// --sweep N: N frames at each grid size below, reporting the rasterize time, the CPU
+// glyph builds (every tile, and diff + changed tiles) and, when g is not NULL, the
+// uploads (char codes, and the changed RGBA spans through the PBOs), each followed by
+// glFinish so the transfer is inside the measurement.
+static const int sweepSizes[][2] = { { 80, 24 }, { 160, 44 }, { 320, 90 }, { 640, 180 }, { 960, 270 }, { 1920, 540 } };
+
+static int run_sweep(int frames, GridTextures* g) {
+    printf("%-10s %8s %9s %10s %10s %10s %10s %10s %10s\n", "grid", "cells", meshLoaded ? "triangles" : "samples",
+           "raster ms", "M/s", "tiles ms", "dirty ms", "chars up", "dirty up");
+    for (size_t k = 0; k < sizeof(sweepSizes) / sizeof(sweepSizes[0]); ++k) {
+        if (resize_char_grid(sweepSizes[k][0], sweepSizes[k][1]) != 0) return -1;
+        if (g && resize_grid_textures(g) != 0) return -1;
+        const size_t cells = (size_t)width_chars * height_chars;
+        const size_t texBytes = cells * GLYPH_W * GLYPH_H * 4;
+        unsigned char* tileTex = (unsigned char*)malloc(texBytes);
+        unsigned char* packed = (unsigned char*)malloc(texBytes);
+        if (!tileTex || !packed) {
+            free(tileTex); free(packed);
+            fprintf(stderr, "%dx%d: out of memory\n", width_chars, height_chars);
+            return -1;
+        }
+        double tRaster = 0.0, tTiles = 0.0, tDirty = 0.0, tUpChars = 0.0, tUpDirty = 0.0;
+        for (int f = 0; f < frames; ++f) {
+            double t0 = pacing_now();
+            render_ascii_cubes_to_buffer();
+            double t1 = pacing_now();
+            build_texture_into(tileTex);
+            double t2 = pacing_now();
+            diff_char_rows(prevChars, charBuffer, &dirtySpans);
+            write_dirty_spans(packed, charBuffer, &dirtySpans);
+            double t3 = pacing_now();
+            tRaster += t1 - t0;
+            tTiles += t2 - t1;
+            tDirty += t3 - t2;
+            if (g) {
+                glBindTexture(GL_TEXTURE_2D, g->charTex);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_chars, height_chars, GL_RED_INTEGER, GL_UNSIGNED_BYTE, charBuffer);
+                glBindTexture(GL_TEXTURE_2D, 0);
+                glFinish();
+                double t4 = pacing_now();
+                upload_dirty_spans(&g->uploader, g->tex, charBuffer, &dirtySpans, texPixels);
+                glFinish();
+                tUpChars += t4 - t3;
+                tUpDirty += pacing_now() - t4;
             }
+            A += 0.05f;
+            B += 0.05f;
+            C += 0.01f;
+        }
+        char grid[32], upChars[16] = "-", upDirty[16] = "-";
+        snprintf(grid, sizeof(grid), "%dx%d", width_chars, height_chars);
+        if (g) {
+            snprintf(upChars, sizeof(upChars), "%.3f", tUpChars * 1e3 / frames);
+            snprintf(upDirty, sizeof(upDirty), "%.3f", tUpDirty * 1e3 / frames);
         }
+        long long samples = meshLoaded ? sceneMesh.triangleCount : total_cube_samples();
+        printf("%-10s %8zu %9lld %10.3f %10.1f %10.3f %10.3f %10s %10s\n", grid, cells, samples,
+               tRaster * 1e3 / frames, samples * (double)frames / tRaster * 1e-6,
+               tTiles * 1e3 / frames, tDirty * 1e3 / frames, upChars, upDirty);
+        fflush(stdout);
+        free(tileTex);
+        free(packed);
     }
+    return 0;
 }
 
-int main(void) {
-    // init glfw
-    if (!glfwInit()) {
-        fprintf(stderr, "GLFW init failed\n");
+// ========== Terminal backend ==========
+static volatile sig_atomic_t terminalStop = 0;
+static void terminal_sigint(int sig) { (void)sig; terminalStop = 1; }
+
+// Face color shaded by depth (ooz is about 1/135 at the back, 1/65 at the front).
+// The shade has few levels so neighbouring cells share colors and a rotating face
+// does not change the color of every cell on every frame.
+#define TERM_SHADE_LEVELS 6
+static uint32_t cell_color(unsigned char ch, float ooz) {
+    uint32_t base;
+    switch (ch) {
+    case '@': base = 0xff5a3c; break;
+    case '$': base = 0x50dc78; break;
+    case '~': base = 0x5a96ff; break;
+    case '#': base = 0xf0dc50; break;
+    case ';': base = 0xc86ef0; break;
+    case '+': base = 0x50dce6; break;
+    // mesh shading ramp chars the faces don't use, dim to bright
+    case ',': base = 0x5a5a78; break;
+    case '-': base = 0x6e6e8c; break;
+    case ':': base = 0x8282a0; break;
+    case '=': base = 0x9696b4; break;
+    case '!': base = 0xaaaac8; break;
+    case '*': base = 0xc8c8dc; break;
+    default: return 0x464646;   // background
+    }
+    float t = (ooz - 1.0f / 135.0f) / (1.0f / 65.0f - 1.0f / 135.0f);
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    float k = 0.45f + 0.55f * (float)(int)(t * (TERM_SHADE_LEVELS - 1) + 0.5f) / (TERM_SHADE_LEVELS - 1);
+    uint32_t r = (uint32_t)(((base >> 16) & 255u) * k);
+    uint32_t g = (uint32_t)(((base >> 8) & 255u) * k);
+    uint32_t b = (uint32_t)((base & 255u) * k);
+    return (r << 16) | (g << 8) | b;
+}
+
+// Grid size for the terminal: everything but the last row, which keeps the cursor
+// and the summary line
+static int terminal_grid_size(int* cols, int* rows) {
+    if (term_out_query_size(cols, rows) != 0) return -1;
+    if (*rows > 1) *rows -= 1;
+    return 0;
+}
+
+typedef struct {
+    TermOut* term;
+    const unsigned char* chars;
+    uint32_t* colors[2];             // [0] goes with chars, [1] is filled by the raster thread
+} TerminalFrame;
+
+static void terminal_present(void* ctx) {
+    TerminalFrame* f = (TerminalFrame*)ctx;
+    term_out_frame(f->term, f->chars, terminalColor ? f->colors[0] : NULL);
+}
+
+static void terminal_shade(void* ctx) {
+    uint32_t* colors = ((TerminalFrame*)ctx)->colors[1];
+    if (terminalColor)
+        for (int i = 0; i < width_chars * height_chars; ++i) colors[i] = cell_color(charBuffer[i], zBuffer[i]);
+}
+
+// The rasterizer straight to stdout: no window, no GL calls. Ctrl-C stops it cleanly.
+// Without --cols / --rows the grid follows the terminal size.
+static int run_terminal(void) {
+    const int follow = gridCols <= 0 && gridRows <= 0;
+    int cols, rows;
+    if (follow && terminal_grid_size(&cols, &rows) == 0 && resize_char_grid(cols, rows) != 0) {
+        fprintf(stderr, "out of memory\n");
+        return -1;
+    }
+    TermOut term;
+    TerminalFrame frame = { &term, NULL, { NULL, NULL } };
+    size_t colorBytes = (size_t)width_chars * height_chars * sizeof(uint32_t);
+    frame.colors[0] = (uint32_t*)calloc(1, colorBytes);
+    frame.colors[1] = (uint32_t*)calloc(1, colorBytes);
+    if (!frame.colors[0] || !frame.colors[1] || term_out_init(&term, width_chars, height_chars, terminalColor) != 0) {
+        fprintf(stderr, "out of memory\n");
+        free(frame.colors[0]);
+        free(frame.colors[1]);
+        return -1;
+    }
+    PipelineJob job = { terminal_present, &frame, terminal_shade, &frame };
+    SimClock clock;
+    signal(SIGINT, terminal_sigint);
+    double start = pacing_now();
+    sim_clock_init(&clock, start);
+    int rc = 0;
+    for (int n = 0; !terminalStop && (runFrames <= 0 || n < runFrames); ++n) {
+        frame_pacer_wait(&framePacer);
+        if (follow && terminal_grid_size(&cols, &rows) == 0 && (cols != width_chars || rows != height_chars)) {
+            colorBytes = (size_t)cols * rows * sizeof(uint32_t);
+            uint32_t* c0 = (uint32_t*)realloc(frame.colors[0], colorBytes);
+            if (c0) frame.colors[0] = c0;
+            uint32_t* c1 = (uint32_t*)realloc(frame.colors[1], colorBytes);
+            if (c1) frame.colors[1] = c1;
+            if (!c0 || !c1 || resize_char_grid(cols, rows) != 0 || term_out_resize(&term, width_chars, height_chars) != 0) {
+                rc = -1;
+                break;
+            }
+            memset(frame.colors[0], 0, colorBytes);
+        }
+        sim_clock_advance(&clock, pacing_now());
+        if (pipelined) {
+            // present what the last run rasterized while the raster thread does the next frame
+            swap_frame_chars();
+            uint32_t* c = frame.colors[0]; frame.colors[0] = frame.colors[1]; frame.colors[1] = c;
+            frame.chars = presentChars;
+            worker_pool_run(pipePool, pipeline_worker, &job);
+        } else {
+            render_ascii_cubes_to_buffer();
+            terminal_shade(&frame);
+            uint32_t* c = frame.colors[0]; frame.colors[0] = frame.colors[1]; frame.colors[1] = c;
+            frame.chars = charBuffer;
+            terminal_present(&frame);
+        }
+    }
+    double elapsed = pacing_now() - start;
+    unsigned long long frames = term.frames, bytes = term.bytes;
+    size_t fullBytes = term.firstFrameBytes;
+    term_out_free(&term);
+    free(frame.colors[0]);
+    free(frame.colors[1]);
+    if (rc != 0) fprintf(stderr, "out of memory\n");
+    if (frames > 0) {
+        fprintf(stderr, "terminal: %llu frames, %.1f fps, %.1f KB/frame (first, full frame: %.1f KB)\n",
+                frames, elapsed > 0.0 ? frames / elapsed : 0.0, bytes / 1024.0 / frames, fullBytes / 1024.0);
+    }
+    return rc;
+}
+
+// ========== Window backend ==========
+typedef struct {
+    GLFWwindow* window;
+    GridTextures* grid;
+    GLuint prog, progCells, atlasTex, quadVAO;
+    const unsigned char* chars;      // the frame to show
+    int fbW, fbH;
+    unsigned long long charUploadFrames;
+} WindowFrame;
+
+// Uploads f->chars, draws the quad and swaps; runs on the thread owning the context
+static void window_present(void* ctx) {
+    WindowFrame* f = (WindowFrame*)ctx;
+    GridTextures* grid = f->grid;
+    if (cpuGlyphs) {
+        // changed cells only: rebuild their tiles and upload those spans through a PBO
+        diff_char_rows(prevChars, f->chars, &dirtySpans);
+        upload_dirty_spans(&grid->uploader, grid->tex, f->chars, &dirtySpans, texPixels);
+    } else {
+        // char codes only (1 byte per cell); the fragment shader expands the glyphs
+        glBindTexture(GL_TEXTURE_2D, grid->charTex);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_chars, height_chars, GL_RED_INTEGER, GL_UNSIGNED_BYTE, f->chars);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        f->charUploadFrames++;
+    }
+
+    // draw
+    glViewport(0, 0, f->fbW, f->fbH);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (cpuGlyphs) {
+        glUseProgram(f->prog);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, grid->tex);
+    } else {
+        glUseProgram(f->progCells);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, f->atlasTex);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, grid->charTex);
+    }
+    glBindVertexArray(f->quadVAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUseProgram(0);
+
+    // swap (events are polled at the top of the loop)
+    glfwSwapBuffers(f->window);
+    frame_log_swapped(&frameLog, pacing_now());
+}
+
+int main(int argc, char** argv) {
+    int benchFrames = 0, sweepFrames = 0;
+    for (int i = 1; i < argc; ++i) {
+        int hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--bench") == 0 && hasValue) benchFrames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sweep") == 0 && hasValue) sweepFrames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--step") == 0 && hasValue) baseStep = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--lattice") == 0 && hasValue) sampleLattice = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--cols") == 0 && hasValue) gridCols = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rows") == 0 && hasValue) gridRows = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) rasterThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cpu-glyphs") == 0) cpuGlyphs = 1;
+        else if (strcmp(argv[i], "--terminal") == 0) terminalMode = 1;
+        else if (strcmp(argv[i], "--color") == 0) terminalColor = 1;
+        else if (strcmp(argv[i], "--frames") == 0 && hasValue) runFrames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sim-hz") == 0 && hasValue) simHz = atof(argv[++i]);
+        else if (strcmp(argv[i], "--pipeline") == 0) pipelined = 1;
+        else if (strcmp(argv[i], "--obj") == 0 && hasValue) objPath = argv[++i];
+        else if (strcmp(argv[i], "--swap") == 0 && hasValue) swapInterval = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0 && hasValue) fpsCap = atof(argv[++i]);
+        else if (strcmp(argv[i], "--latency-csv") == 0 && hasValue) latencyCsv = argv[++i];
+        else fprintf(stderr, "ignoring argument %s\n", argv[i]);
+    }
+
+    if (baseStep < 0.01f) baseStep = 0.01f;
+    if (sampleLattice < 0.01f) sampleLattice = 0.01f;
+    init_glyph_tiles();
+    if (init_raster_pool() != 0 || (pipelined && !(pipePool = worker_pool_create(2))) ||
+        resize_char_grid(gridCols > 0 ? gridCols : DEFAULT_COLS, gridRows > 0 ? gridRows : DEFAULT_ROWS) != 0) {
+        fprintf(stderr, "out of memory\n");
+        shutdown_renderer();
         return -1;
     }
+    if (objPath && load_scene_mesh(objPath) != 0) { shutdown_renderer(); return -1; }
+    if (benchFrames > 0 || terminalMode) {
+        int rc;
+        if (benchFrames > 0) {
+            rc = run_bench(benchFrames);
+        } else {
+            frame_pacer_init(&framePacer, fpsCap);
+            rc = run_terminal();
+        }
+        shutdown_renderer();
+        return rc;
+    }
+
+    // init glfw (the sweep still runs without GL, minus the upload times)
+    if (!glfwInit()) {
+        fprintf(stderr, sweepFrames > 0 ? "GLFW init failed, sweeping without upload times\n" : "GLFW init failed\n");
+        int rc = sweepFrames > 0 ? run_sweep(sweepFrames, NULL) : -1;
+        shutdown_renderer();
+        return rc;
+    }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (sweepFrames > 0) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-    // create window sized to texture
-    GLFWwindow* window = glfwCreateWindow(WIN_W, WIN_H, "ASCII Cube (in-window)", NULL, NULL);
+    // create window sized to the grid; resizing it resizes the grid
+    GLFWwindow* window = glfwCreateWindow(width_chars * GLYPH_W, height_chars * GLYPH_H, "ASCII Cube (in-window)", NULL, NULL);
     if (!window) {
         fprintf(stderr, "Window creation failed\n");
         glfwTerminate();
+        shutdown_renderer();
         return -1;
     }
     glfwMakeContextCurrent(window);
+    glfwSwapInterval(swapInterval < 0 ? 0 : swapInterval);
+    glfwSetCursorPosCallback(window, cursor_pos_cb);
+    frame_pacer_init(&framePacer, fpsCap);
+    frame_log_init(&frameLog);
 
     // init glew
     glewExperimental = GL_TRUE;
@@ -297,7 +769,9 @@ int main(void) {
     GLuint vs = compile_shader(GL_VERTEX_SHADER, vs_src);
     GLuint fs = compile_shader(GL_FRAGMENT_SHADER, fs_src);
     GLuint prog = link_program(vs, fs);
-    glDeleteShader(vs); glDeleteShader(fs);
+    GLuint fsCells = compile_shader(GL_FRAGMENT_SHADER, fs_cells_src);
+    GLuint progCells = link_program(vs, fsCells);
+    glDeleteShader(vs); glDeleteShader(fs); glDeleteShader(fsCells);
 
     // quad (two triangles) covering NDC [-1,1]
     float quadVerts[] = {
@@ -317,92 +791,125 @@ int main(void) {
     glEnableVertexAttribArray(1); glVertexAttribPointer(1,2,GL_FLOAT,GL_FALSE,4*sizeof(float),(void*)(2*sizeof(float)));
     glBindVertexArray(0);
 
-    // create RGBA texture
-    int texW = CHAR_COLS * GLYPH_W;
-    int texH = CHAR_ROWS * GLYPH_H;
-    texPixels = (unsigned char*)malloc(texW * texH * 4);
-    memset(texPixels, 0, texW * texH * 4);
-
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    // allocate once
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texW, texH, 0, GL_RGBA, GL_UNSIGNED_BYTE, texPixels);
+    // RGBA texture (--cpu-glyphs) and char code texture; resize_grid_textures gives them
+    // their size and initial (cleared) contents, later frames upload only what changes
+    GridTextures grid;
+    memset(&grid, 0, sizeof(grid));
+    grid.rgba = cpuGlyphs || sweepFrames > 0;
+    texture_uploader_init(&grid.uploader, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);   // char rows of any width
+    glGenTextures(1, &grid.tex);
+    glBindTexture(GL_TEXTURE_2D, grid.tex);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // keep pixel look
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenTextures(1, &grid.charTex);
+    glBindTexture(GL_TEXTURE_2D, grid.charTex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);   // integer textures cannot filter
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    if (resize_grid_textures(&grid) != 0) { fprintf(stderr, "out of memory\n"); return -1; }
+
+    // glyph atlas for the GPU expansion
+    unsigned char* atlas = (unsigned char*)malloc(ATLAS_W * ATLAS_H);
+    if (!atlas) { fprintf(stderr, "out of memory\n"); return -1; }
+    build_glyph_atlas(atlas);
+    GLuint atlasTex = 0;
+    glGenTextures(1, &atlasTex);
+    glBindTexture(GL_TEXTURE_2D, atlasTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_W, ATLAS_H, 0, GL_RED, GL_UNSIGNED_BYTE, atlas);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glBindTexture(GL_TEXTURE_2D, 0);
+    free(atlas);
 
     // uniform location
     glUseProgram(prog);
     glUniform1i(glGetUniformLocation(prog, "uTex"), 0);
+    glUseProgram(progCells);
+    glUniform1i(glGetUniformLocation(progCells, "uChars"), 0);
+    glUniform1i(glGetUniformLocation(progCells, "uAtlas"), 1);
     glUseProgram(0);
 
-    // initial clear buffers
-    for (int i=0;i<CHAR_COLS*CHAR_ROWS;i++){
-        zBuffer[i] = 0.0f;
-        charBuffer[i] = backgroundASCIICode;
+    int rc = 0;
+    if (sweepFrames > 0) {
+        rc = run_sweep(sweepFrames, &grid);
+        glfwSetWindowShouldClose(window, 1);
     }
 
-    // main loop timing
-    double lastTime = glfwGetTime();
-    const double target_dt = 1.0/60.0; // ~60 FPS
-    while (!glfwWindowShouldClose(window)) {
-        double t = glfwGetTime();
-        double dt = t - lastTime;
-        if (dt < target_dt) {
-            // sleep a bit to be friendly
-            sleep_ms((int)((target_dt - dt)*1000.0));
-            t = glfwGetTime();
-            dt = t - lastTime;
-        }
-        lastTime = t;
+    WindowFrame frame = { window, &grid, prog, progCells, atlasTex, quadVAO, NULL, 0, 0, 0 };
+    PipelineJob job = { window_present, &frame, NULL, NULL };
+    SimClock simClock;
+    sim_clock_init(&simClock, pacing_now());
 
-        // update ascii logic (same as original)
-        render_ascii_cubes_to_buffer();
-
-        // update rotations (same increments as original)
-        A += 0.05f;
-        B += 0.05f;
-        C += 0.01f;
-
-        // build texture from charBuffer -> texPixels
-        build_texture_from_charbuffer();
-
-        // upload to GPU (fast subimage upload)
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texW, texH, GL_RGBA, GL_UNSIGNED_BYTE, texPixels);
-        glBindTexture(GL_TEXTURE_2D, 0);
+    int framesDrawn = 0;
+    while (!glfwWindowShouldClose(window)) {
+        // wait for the frame slot (~60 FPS by default), then sample input
+        frame_pacer_wait(&framePacer);
+        glfwPollEvents();
+        if (!pipelined) frame_log_begin(&frameLog);
 
-        // draw
+        // follow the window: one cell per glyph of framebuffer (unless --cols / --rows)
         int fbW, fbH;
         glfwGetFramebufferSize(window, &fbW, &fbH);
-        glViewport(0,0,fbW,fbH);
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        int cols = gridCols > 0 ? gridCols : fbW / GLYPH_W;
+        int rows = gridRows > 0 ? gridRows : fbH / GLYPH_H;
+        if (fbW > 0 && fbH > 0 && (cols != width_chars || rows != height_chars)) {
+            if (resize_char_grid(cols, rows) != 0 || resize_grid_textures(&grid) != 0) {
+                fprintf(stderr, "out of memory at %dx%d cells\n", cols, rows);
+                rc = -1;
+                break;
+            }
+        }
 
-        glUseProgram(prog);
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glBindVertexArray(quadVAO);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        glBindVertexArray(0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        glUseProgram(0);
+        // update rotations on the fixed timestep, then draw
+        sim_clock_advance(&simClock, pacing_now());
+        frame.fbW = fbW;
+        frame.fbH = fbH;
+        if (pipelined) {
+            // present what the last run rasterized while the raster thread does the next frame
+            swap_frame_chars();
+            frame.chars = presentChars;
+            worker_pool_run(pipePool, pipeline_worker, &job);
+            // input polled this iteration first shows in the frame just rasterized
+            frame_log_begin(&frameLog);
+        } else {
+            render_ascii_cubes_to_buffer();
+            frame.chars = charBuffer;
+            window_present(&frame);
+        }
+        if (runFrames > 0 && ++framesDrawn >= runFrames) glfwSetWindowShouldClose(window, 1);
+    }
 
-        // poll events & swap
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    const double rgbaKB = (double)width_chars * GLYPH_W * height_chars * GLYPH_H * 4 / 1024.0;
+    if (sweepFrames == 0) frame_log_print_summary(&frameLog, stderr);
+    if (frame.charUploadFrames > 0) {
+        fprintf(stderr, "texture upload: %.1f KB/frame of char codes (RGBA would be %.1f KB)\n",
+                width_chars * height_chars / 1024.0, rgbaKB);
+    }
+    if (sweepFrames == 0 && grid.uploader.frames > 0) {
+        fprintf(stderr, "texture upload: %.1f KB/frame of %.1f KB full, %.0f changed cells/frame\n",
+                grid.uploader.uploadedBytes / 1024.0 / grid.uploader.frames, rgbaKB,
+                (double)grid.uploader.changedCells / grid.uploader.frames);
     }
+    if (latencyCsv) {
+        if (frame_log_write_csv(&frameLog, latencyCsv) == 0) fprintf(stderr, "frame log written to %s\n", latencyCsv);
+        else fprintf(stderr, "could not write %s\n", latencyCsv);
+    }
+    frame_log_free(&frameLog);
 
     // cleanup
-    if (tex) glDeleteTextures(1, &tex);
+    texture_uploader_free(&grid.uploader);
+    if (grid.tex) glDeleteTextures(1, &grid.tex);
+    if (grid.charTex) glDeleteTextures(1, &grid.charTex);
+    if (atlasTex) glDeleteTextures(1, &atlasTex);
     if (quadVBO) glDeleteBuffers(1, &quadVBO);
     if (quadVAO) glDeleteVertexArrays(1, &quadVAO);
     if (prog) glDeleteProgram(prog);
+    if (progCells) glDeleteProgram(progCells);
 
-    if (texPixels) free(texPixels);
+    shutdown_renderer();
 
     glfwDestroyWindow(window);
     glfwTerminate();
-    return 0;
+    return rc;
 }
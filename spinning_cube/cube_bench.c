@@ -0,0 +1,221 @@
+// cube_bench.c
+// Headless benchmark of the ASCII cube kernels (no window, no GL, no display):
+// render_ascii_cubes_to_buffer and build_texture_from_charbuffer for N iterations over
+// a fixed cycle of angles, with ns/frame summaries, then output checks.
+//
+//   cube_bench [--frames N] [--warmup N] [--threads T] [--cols C] [--rows R]
+//              [--step S] [--lattice L] [--obj FILE] [--expect HEX]
+//
+// Checks that hold on any toolchain:
+//  - the default configuration (160x44, step 0.6, lattice 1, cubes) at A = B = C = 0
+//    against a built-in checksum: sin/cos of 0 are exact in every libm, so the frame is
+//    plain IEEE float arithmetic
+//  - every angle of the cycle (cubes) against render_ascii_cubes_reference, the
+//    per-sample trig path: at most MAX_REFERENCE_DIFF of the cells may differ (the
+//    kernels build one rotation matrix, so a libm may round a few cells differently)
+//  - the glyph texture of every angle against build_texture_reference, exactly
+// The checksum of the chars and RGBA texture of the whole cycle depends on the libm's
+// sinf / cosf, so it is only compared with --expect, for regression checks on one
+// toolchain. The scalar and SIMD kernels and any thread count give the same bytes.
+// Exit status: 0 ok, 1 check failed, 2 bad arguments or setup failure.
+
+#include "ascii_raster.h"
+#include "frame_pacing.h"
+#include "glyph_texture.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Angles of iteration i: step i % BENCH_ANGLES of 8 animation frames each
+#define BENCH_ANGLES 16
+// Chars + RGBA of the default configuration at A = B = C = 0
+#define DEFAULT_CHECKSUM 0x477db83d0d7db7afULL
+// Fraction of cells allowed to differ from the reference path
+#define MAX_REFERENCE_DIFF 0.005
+
+static void set_bench_angles(int i) {
+    int k = i % BENCH_ANGLES;
+    A = 0.4f * k;
+    B = 0.4f * k;
+    C = 0.08f * k;
+}
+
+// FNV-1a, 64 bit
+static uint64_t fnv1a(uint64_t h, const unsigned char* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+typedef struct {
+    double min, median, mean, p95, p99, max, stddev;
+} Summary;
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts v in place
+static Summary summarize(double* v, int n) {
+    Summary s;
+    qsort(v, (size_t)n, sizeof(double), cmp_double);
+    double sum = 0.0, sq = 0.0;
+    for (int i = 0; i < n; ++i) sum += v[i];
+    s.mean = sum / n;
+    for (int i = 0; i < n; ++i) sq += (v[i] - s.mean) * (v[i] - s.mean);
+    s.stddev = n > 1 ? sqrt(sq / (n - 1)) : 0.0;
+    s.min = v[0];
+    s.max = v[n - 1];
+    s.median = n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+    s.p95 = v[(int)(0.95 * (n - 1) + 0.5)];
+    s.p99 = v[(int)(0.99 * (n - 1) + 0.5)];
+    return s;
+}
+
+static void print_summary(const char* name, const Summary* s) {
+    printf("%-30s %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f %10.0f\n", name,
+           s->min, s->median, s->mean, s->p95, s->p99, s->max, s->stddev);
+}
+
+int main(int argc, char** argv) {
+    int frames = 500, warmup = 50, cols = DEFAULT_COLS, rows = DEFAULT_ROWS;
+    const char* objPath = NULL;
+    const char* expectArg = NULL;
+    for (int i = 1; i < argc; ++i) {
+        int hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue) frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue) warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && hasValue) rasterThreads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cols") == 0 && hasValue) cols = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rows") == 0 && hasValue) rows = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--step") == 0 && hasValue) baseStep = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--lattice") == 0 && hasValue) sampleLattice = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--obj") == 0 && hasValue) objPath = argv[++i];
+        else if (strcmp(argv[i], "--expect") == 0 && hasValue) expectArg = argv[++i];
+        else {
+            fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (frames < 1 || warmup < 0 || baseStep < 0.01f || sampleLattice < 0.01f) {
+        fprintf(stderr, "bad --frames / --warmup / --step / --lattice\n");
+        return 2;
+    }
+
+    init_glyph_tiles();
+    if (init_raster_pool() != 0 || raster_resize_grid(cols, rows) != 0 || glyph_resize_grid() != 0) {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+    if (objPath && load_scene_mesh(objPath) != 0) return 2;
+    const size_t cells = (size_t)width_chars * height_chars;
+    const size_t texBytes = cells * GLYPH_W * GLYPH_H * 4;
+    texPixels = (unsigned char*)malloc(texBytes);
+    unsigned char* refTex = (unsigned char*)malloc(texBytes);
+    unsigned char* refChars = (unsigned char*)malloc(cells);
+    double* rasterNs = (double*)malloc(frames * sizeof(double));
+    double* textureNs = (double*)malloc(frames * sizeof(double));
+    double* frameNs = (double*)malloc(frames * sizeof(double));
+    if (!texPixels || !refTex || !refChars || !rasterNs || !textureNs || !frameNs) {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+
+    for (int i = 0; i < warmup; ++i) {
+        set_bench_angles(i);
+        render_ascii_cubes_to_buffer();
+        build_texture_from_charbuffer();
+    }
+    for (int i = 0; i < frames; ++i) {
+        set_bench_angles(i);
+        double t0 = pacing_now();
+        render_ascii_cubes_to_buffer();
+        double t1 = pacing_now();
+        build_texture_from_charbuffer();
+        double t2 = pacing_now();
+        rasterNs[i] = (t1 - t0) * 1e9;
+        textureNs[i] = (t2 - t1) * 1e9;
+        frameNs[i] = (t2 - t0) * 1e9;
+    }
+
+    // cycle checksum, texture vs reference, cubes vs the per-sample trig path
+    uint64_t checksum = 0xcbf29ce484222325ULL;
+    long long worstDiff = 0, textureDiffs = 0;
+    for (int k = 0; k < BENCH_ANGLES; ++k) {
+        set_bench_angles(k);
+        render_ascii_cubes_to_buffer();
+        build_texture_from_charbuffer();
+        checksum = fnv1a(checksum, charBuffer, cells);
+        checksum = fnv1a(checksum, texPixels, texBytes);
+        build_texture_reference(refTex);
+        textureDiffs += memcmp(refTex, texPixels, texBytes) != 0;
+        if (meshLoaded) continue;
+        memcpy(refChars, charBuffer, cells);
+        render_ascii_cubes_reference();
+        long long diff = 0;
+        for (size_t i = 0; i < cells; ++i) diff += refChars[i] != charBuffer[i];
+        if (diff > worstDiff) worstDiff = diff;
+    }
+
+    long long work = meshLoaded ? sceneMesh.triangleCount : total_cube_samples();
+    printf("cube_bench: %dx%d cells, %lld %s/frame, %s kernel, %d threads, %d frames (%d warm-up)\n",
+           width_chars, height_chars, work, meshLoaded ? "triangles" : "samples", rasterSimdName,
+           worker_pool_size(rasterPool), frames, warmup);
+    printf("%-30s %10s %10s %10s %10s %10s %10s %10s\n", "ns/frame", "min", "median", "mean", "p95", "p99", "max", "stddev");
+    Summary s = summarize(rasterNs, frames);
+    print_summary("render_ascii_cubes_to_buffer", &s);
+    s = summarize(textureNs, frames);
+    print_summary("build_texture_from_charbuffer", &s);
+    s = summarize(frameNs, frames);
+    print_summary("frame", &s);
+
+    int rc = 0;
+    printf("texture vs build_texture_reference: %s\n", textureDiffs ? "MISMATCH" : "ok");
+    if (textureDiffs) rc = 1;
+    if (!meshLoaded) {
+        const long long allowed = (long long)(MAX_REFERENCE_DIFF * cells);
+        printf("cells vs render_ascii_cubes_reference: worst %lld of %zu differ (max %lld): %s\n",
+               worstDiff, cells, allowed, worstDiff > allowed ? "MISMATCH" : "ok");
+        if (worstDiff > allowed) rc = 1;
+    }
+    const int isDefault = !objPath && width_chars == DEFAULT_COLS && height_chars == DEFAULT_ROWS && baseStep == 0.6f &&
+                          sampleLattice == 1.0f;
+    if (isDefault) {
+        A = B = C = 0.0f;
+        render_ascii_cubes_to_buffer();
+        build_texture_from_charbuffer();
+        uint64_t still = fnv1a(fnv1a(0xcbf29ce484222325ULL, charBuffer, cells), texPixels, texBytes);
+        printf("checksum at rest %016" PRIx64 " (expected %016" PRIx64 "): %s\n", still, (uint64_t)DEFAULT_CHECKSUM,
+               still == DEFAULT_CHECKSUM ? "ok" : "MISMATCH");
+        if (still != DEFAULT_CHECKSUM) rc = 1;
+    }
+    if (expectArg) {
+        uint64_t expected = (uint64_t)strtoull(expectArg, NULL, 16);
+        printf("checksum %016" PRIx64 " (expected %016" PRIx64 "): %s\n", checksum, expected,
+               checksum == expected ? "ok" : "MISMATCH");
+        if (checksum != expected) rc = 1;
+    } else {
+        printf("checksum %016" PRIx64 " (toolchain dependent, compared with --expect)\n", checksum);
+    }
+
+    free(rasterNs);
+    free(textureNs);
+    free(frameNs);
+    free(refTex);
+    free(refChars);
+    free(texPixels);
+    texPixels = NULL;
+    free_scene_mesh();
+    free_raster_pool();
+    free_cube_samples();
+    glyph_free_grid();
+    raster_free_grid();
+    return rc;
+}
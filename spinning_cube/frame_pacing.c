@@ -0,0 +1,168 @@
+// frame_pacing.c
+// Frame limiter and latency log, see frame_pacing.h.
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L   // clock_gettime / nanosleep under strict C11
+#endif
+
+#include "frame_pacing.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#else
+#include <sched.h>
+#include <time.h>
+#endif
+
+double pacing_now(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    return (double)c.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void os_sleep(double seconds) {
+#ifdef _WIN32
+    static int fine_period = 0;
+    if (!fine_period) { timeBeginPeriod(1); fine_period = 1; }   // 1 ms scheduler tick
+    Sleep((DWORD)(seconds * 1000.0));
+#else
+    struct timespec req;
+    req.tv_sec = (time_t)seconds;
+    req.tv_nsec = (long)((seconds - (double)req.tv_sec) * 1e9);
+    nanosleep(&req, NULL);
+#endif
+}
+
+static void os_yield(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+void frame_pacer_init(FramePacer* p, double fps) {
+    p->fps = fps > 0.0 ? fps : 0.0;
+    p->spin_margin = 0.002;
+    p->oversleep = 0.0;
+    p->next_deadline = 0.0;
+}
+
+void frame_pacer_wait(FramePacer* p) {
+    if (p->fps <= 0.0) return;
+    double period = 1.0 / p->fps;
+    double now = pacing_now();
+    // first frame, or a stall longer than a period: restart the slots from now
+    if (p->next_deadline <= 0.0 || now - p->next_deadline > period) p->next_deadline = now;
+
+    double sleep_for = p->next_deadline - now - p->spin_margin;
+    if (sleep_for > 0.0) {
+        double before = pacing_now();
+        os_sleep(sleep_for);
+        double over = (pacing_now() - before) - sleep_for;
+        if (over < 0.0) over = 0.0;
+        p->oversleep = p->oversleep * 0.9 + over * 0.1;
+        p->spin_margin = p->oversleep * 2.0 + 0.0002;
+        if (p->spin_margin < 0.0005) p->spin_margin = 0.0005;
+        if (p->spin_margin > 0.004) p->spin_margin = 0.004;
+    }
+    while (pacing_now() < p->next_deadline) os_yield();
+    p->next_deadline += period;
+}
+
+void frame_log_init(FrameLog* log) {
+    memset(log, 0, sizeof(*log));
+    log->max_frames = (size_t)1 << 20;
+}
+
+void frame_log_free(FrameLog* log) {
+    free(log->interval_ms);
+    free(log->latency_ms);
+    frame_log_init(log);
+}
+
+void frame_log_input(FrameLog* log, double t) {
+    if (log->pending_input <= 0.0) log->pending_input = t;
+}
+
+void frame_log_begin(FrameLog* log) {
+    if (log->in_flight_input <= 0.0) log->in_flight_input = log->pending_input;
+    log->pending_input = 0.0;
+}
+
+void frame_log_swapped(FrameLog* log, double t) {
+    if (log->last_swap > 0.0 && log->count < log->max_frames) {
+        if (log->count == log->capacity) {
+            size_t cap = log->capacity ? log->capacity * 2 : 4096;
+            float* iv = (float*)realloc(log->interval_ms, cap * sizeof(float));
+            if (iv) log->interval_ms = iv;
+            float* lv = (float*)realloc(log->latency_ms, cap * sizeof(float));
+            if (lv) log->latency_ms = lv;
+            if (iv && lv) log->capacity = cap;
+        }
+        if (log->count < log->capacity) {
+            log->interval_ms[log->count] = (float)((t - log->last_swap) * 1e3);
+            log->latency_ms[log->count] = log->in_flight_input > 0.0 ? (float)((t - log->in_flight_input) * 1e3) : -1.0f;
+            log->count++;
+        }
+    }
+    log->last_swap = t;
+    log->in_flight_input = 0.0;
+}
+
+static int cmp_float(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+static float percentile(const float* sorted, size_t n, double q) {
+    if (n == 0) return 0.0f;
+    size_t i = (size_t)(q * (double)(n - 1) + 0.5);
+    return sorted[i < n ? i : n - 1];
+}
+
+void frame_log_print_summary(const FrameLog* log, FILE* out) {
+    if (log->count == 0) { fprintf(out, "frames: 0\n"); return; }
+    float* iv = (float*)malloc(log->count * sizeof(float));
+    float* lv = (float*)malloc(log->count * sizeof(float));
+    if (!iv || !lv) { free(iv); free(lv); return; }
+    double sum = 0.0;
+    size_t nl = 0;
+    for (size_t i = 0; i < log->count; ++i) {
+        iv[i] = log->interval_ms[i];
+        sum += iv[i];
+        if (log->latency_ms[i] >= 0.0f) lv[nl++] = log->latency_ms[i];
+    }
+    qsort(iv, log->count, sizeof(float), cmp_float);
+    qsort(lv, nl, sizeof(float), cmp_float);
+    fprintf(out, "frames: %zu  interval mean %.2f ms, p99 %.2f ms\n",
+            log->count, sum / (double)log->count, percentile(iv, log->count, 0.99));
+    fprintf(out, "input-to-swap latency (%zu samples): p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+            nl, percentile(lv, nl, 0.50), percentile(lv, nl, 0.90), percentile(lv, nl, 0.99),
+            nl ? lv[nl - 1] : 0.0f);
+    free(iv);
+    free(lv);
+}
+
+int frame_log_write_csv(const FrameLog* log, const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fprintf(f, "frame,interval_ms,latency_ms\n");
+    for (size_t i = 0; i < log->count; ++i) {
+        if (log->latency_ms[i] >= 0.0f) fprintf(f, "%zu,%.4f,%.4f\n", i, log->interval_ms[i], log->latency_ms[i]);
+        else fprintf(f, "%zu,%.4f,\n", i, log->interval_ms[i]);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
@@ -0,0 +1,44 @@
+// frame_pacing.h
+// Frame limiter and input-latency log for the cube (no GL / GLFW dependency).
+//  - frame_pacer_wait waits for fixed frame slots of 1/fps: an OS sleep for most of
+//    the wait, then a spin on the monotonic clock for the last spin_margin seconds.
+//    The margin follows the measured oversleep.
+//  - FrameLog records per-frame interval and input-to-swap latency; input callbacks
+//    stamp the oldest event not yet shown, the next swap closes it. CSV export.
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+double pacing_now(void);   // seconds, monotonic
+
+typedef struct {
+    double fps;            // 0 = uncapped
+    double spin_margin;
+    double oversleep;      // smoothed sleep overshoot
+    double next_deadline;
+} FramePacer;
+
+void frame_pacer_init(FramePacer* p, double fps);
+void frame_pacer_wait(FramePacer* p);
+
+typedef struct {
+    float* interval_ms;    // swap-to-swap time
+    float* latency_ms;     // input-to-swap, < 0 when the frame reflected no input
+    size_t count, capacity, max_frames;
+    double last_swap;
+    double pending_input;  // oldest input not yet picked up by a frame
+    double in_flight_input;
+} FrameLog;
+
+void frame_log_init(FrameLog* log);
+void frame_log_free(FrameLog* log);
+void frame_log_input(FrameLog* log, double t);    // from input callbacks
+void frame_log_begin(FrameLog* log);              // after polling events
+void frame_log_swapped(FrameLog* log, double t);  // right after the buffer swap
+void frame_log_print_summary(const FrameLog* log, FILE* out);
+// frame,interval_ms,latency_ms (latency empty when the frame had no input); 0 on success
+int frame_log_write_csv(const FrameLog* log, const char* path);
+
+#endif
@@ -0,0 +1,228 @@
+// glyph_texture.c
+// CPU glyph texture, see glyph_texture.h.
+
+#include "glyph_texture.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// ========== Small 8x8 bitmap font for the chars we use =========
+// Each glyph is 8 bytes (rows), LSB is leftmost pixel. 1 => pixel on.
+typedef unsigned char GlyphRow;
+typedef struct { char ch; GlyphRow rows[GLYPH_H]; } GlyphEntry;
+
+// We only need glyphs for the cube faces ('@', '$', '~', '#', ';', '+'), the background
+// '.', space, and the mesh shading ramp of ascii_raster.c (",-~:;=!*#$@").
+// Glyph patterns are simple approximations (not full font).
+static GlyphEntry glyphs[] = {
+    // '@' approximate
+    {'@', {0x3C,0x42,0x9D,0x9D,0x9B,0x40,0x3C,0x00}},
+    // '$' approximate
+    {'$', {0x08,0x3E,0x28,0x3C,0x0A,0x3E,0x08,0x00}},
+    // '~' approximate (wavy)
+    {'~', {0x00,0x00,0x18,0x24,0x12,0x00,0x00,0x00}},
+    // '#' hash
+    {'#', {0x00,0x24,0x7E,0x24,0x7E,0x24,0x00,0x00}},
+    // ';' semicolon (dot + short vertical)
+    {';', {0x00,0x00,0x18,0x18,0x18,0x10,0x10,0x08}},
+    // '+' plus
+    {'+', {0x00,0x08,0x08,0x3E,0x08,0x08,0x00,0x00}},
+    // '.' dot
+    {'.', {0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00}},
+    // ',' comma
+    {',', {0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x30}},
+    // '-' dash
+    {'-', {0x00,0x00,0x00,0x3C,0x00,0x00,0x00,0x00}},
+    // ':' colon
+    {':', {0x00,0x18,0x18,0x00,0x00,0x18,0x18,0x00}},
+    // '=' equals
+    {'=', {0x00,0x00,0x3C,0x00,0x3C,0x00,0x00,0x00}},
+    // '!' bang
+    {'!', {0x18,0x18,0x18,0x18,0x18,0x00,0x18,0x00}},
+    // '*' star
+    {'*', {0x00,0x24,0x18,0x7E,0x18,0x24,0x00,0x00}},
+    // ' ' space
+    {' ', {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}},
+};
+
+// Find glyph by char (linear search small table)
+static const GlyphRow* find_glyph(char c) {
+    for (size_t i = 0; i < sizeof(glyphs)/sizeof(glyphs[0]); ++i) {
+        if (glyphs[i].ch == c) return glyphs[i].rows;
+    }
+    return NULL;
+}
+
+// CPU copy of the RGBA glyph texture (width_chars * GLYPH_W x height_chars * GLYPH_H)
+unsigned char* texPixels = NULL;
+
+// Reference texture build: per-cell glyph search and per-bit writes (kept for --bench)
+void build_texture_reference(unsigned char* out) {
+    int texW = width_chars * GLYPH_W;
+    int texH = height_chars * GLYPH_H;
+    // fill black
+    memset(out, 0, texW * texH * 4);
+
+    for (int cy = 0; cy < height_chars; ++cy) {
+        for (int cx = 0; cx < width_chars; ++cx) {
+            unsigned char ch = charBuffer[cx + cy * width_chars];
+            const GlyphRow* g = find_glyph((char)ch);
+            if (!g) g = find_glyph(' '); // fallback
+            // top-left pixel of this glyph in texture
+            int px = cx * GLYPH_W;
+            int py = cy * GLYPH_H;
+            for (int gy = 0; gy < GLYPH_H; ++gy) {
+                GlyphRow row = g[gy];
+                for (int gx = 0; gx < GLYPH_W; ++gx) {
+                    int bit = (row >> (7 - gx)) & 1;
+                    int tx = px + gx;
+                    int ty = py + gy;
+                    int tidx = (ty * texW + tx) * 4;
+                    if (bit) {
+                        // white opaque pixel (you can change color here)
+                        out[tidx + 0] = 255;
+                        out[tidx + 1] = 255;
+                        out[tidx + 2] = 255;
+                        out[tidx + 3] = 255;
+                    } else {
+                        // leave transparent / black
+                        out[tidx + 0] = 0;
+                        out[tidx + 1] = 0;
+                        out[tidx + 2] = 0;
+                        out[tidx + 3] = 255; // opaque black background
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ========== Glyph tiles ==========
+// Every char code maps straight to its glyph expanded to RGBA (8 rows x 32 bytes);
+// codes without a glyph get the space tile, like the find_glyph fallback. A texture
+// row of a char row is then width_chars copies of 32 bytes.
+static unsigned char glyphTiles[256][GLYPH_H][GLYPH_ROW_BYTES];
+
+void init_glyph_tiles(void) {
+    const GlyphRow* space = find_glyph(' ');
+    for (int code = 0; code < 256; ++code) {
+        const GlyphRow* g = find_glyph((char)code);
+        if (!g) g = space;
+        for (int gy = 0; gy < GLYPH_H; ++gy) {
+            for (int gx = 0; gx < GLYPH_W; ++gx) {
+                unsigned char v = ((g[gy] >> (7 - gx)) & 1) ? 255 : 0;
+                unsigned char* px = &glyphTiles[code][gy][gx * 4];
+                px[0] = v; px[1] = v; px[2] = v; px[3] = 255;
+            }
+        }
+    }
+}
+
+// Char rows [rowBegin, rowEnd) of chars into out (texture of width_chars x height_chars cells)
+static void build_texture_rows(unsigned char* out, const unsigned char* chars, int rowBegin, int rowEnd) {
+    const size_t texRowBytes = (size_t)width_chars * GLYPH_ROW_BYTES;
+    for (int cy = rowBegin; cy < rowEnd; ++cy) {
+        const unsigned char* rowChars = chars + (size_t)cy * width_chars;
+        for (int gy = 0; gy < GLYPH_H; ++gy) {
+            unsigned char* dst = out + ((size_t)cy * GLYPH_H + gy) * texRowBytes;
+            for (int cx = 0; cx < width_chars; ++cx, dst += GLYPH_ROW_BYTES)
+                memcpy(dst, glyphTiles[rowChars[cx]][gy], GLYPH_ROW_BYTES);
+        }
+    }
+}
+
+typedef struct {
+    unsigned char* out;
+    const unsigned char* chars;
+} TextureJob;
+
+static void texture_worker(void* ctx, int worker, int workers) {
+    const TextureJob* job = (const TextureJob*)ctx;
+    build_texture_rows(job->out, job->chars, height_chars * worker / workers, height_chars * (worker + 1) / workers);
+}
+
+// Fill out using charBuffer and the glyph tiles (white glyph on black bg), bands of
+// char rows on the raster pool
+void build_texture_into(unsigned char* out) {
+    TextureJob job = { out, charBuffer };
+    worker_pool_run(rasterPool, texture_worker, &job);
+}
+
+void build_texture_from_charbuffer(void) {
+    build_texture_into(texPixels);
+}
+
+// Glyph atlas for fs_cells_src: code c at cell (c % 16, c / 16), 255 where the glyph bit is set
+void build_glyph_atlas(unsigned char* atlas) {
+    for (int code = 0; code < 256; ++code) {
+        int ax = (code % 16) * GLYPH_W, ay = (code / 16) * GLYPH_H;
+        for (int gy = 0; gy < GLYPH_H; ++gy)
+            for (int gx = 0; gx < GLYPH_W; ++gx)
+                atlas[(ay + gy) * ATLAS_W + ax + gx] = glyphTiles[code][gy][gx * 4];
+    }
+}
+
+// ========== Dirty cells ==========
+// prevChars holds the chars the texture currently shows. Each frame the new charBuffer
+// is diffed against it row by row; every char row with a change gives one span
+// [colBegin, colEnd) covering its changed cells. Only those tiles are written, packed
+// span after span (GLYPH_H rows of span width * 32 bytes each), and only those
+// rectangles are uploaded.
+DirtySpans dirtySpans;               // sized with the grid (glyph_resize_grid)
+unsigned char* prevChars = NULL;
+
+// Diffs chars against prev, records the spans and updates prev
+void diff_char_rows(unsigned char* prev, const unsigned char* chars, DirtySpans* d) {
+    d->count = 0;
+    d->bytes = 0;
+    d->cells = 0;
+    for (int cy = 0; cy < height_chars; ++cy) {
+        int begin = -1, end = -1;
+        for (int cx = 0; cx < width_chars; ++cx) {
+            int i = cx + cy * width_chars;
+            if (prev[i] != chars[i]) {
+                if (begin < 0) begin = cx;
+                end = cx + 1;
+                prev[i] = chars[i];
+                d->cells++;
+            }
+        }
+        if (begin < 0) continue;
+        d->row[d->count] = cy;
+        d->colBegin[d->count] = begin;
+        d->colEnd[d->count] = end;
+        d->offset[d->count] = d->bytes;
+        d->bytes += (size_t)(end - begin) * GLYPH_ROW_BYTES * GLYPH_H;
+        d->count++;
+    }
+}
+
+void write_dirty_spans(unsigned char* dst, const unsigned char* chars, const DirtySpans* d) {
+    for (int k = 0; k < d->count; ++k) {
+        const unsigned char* rowChars = chars + (size_t)d->row[k] * width_chars;
+        unsigned char* out = dst + d->offset[k];
+        for (int gy = 0; gy < GLYPH_H; ++gy)
+            for (int cx = d->colBegin[k]; cx < d->colEnd[k]; ++cx, out += GLYPH_ROW_BYTES)
+                memcpy(out, glyphTiles[rowChars[cx]][gy], GLYPH_ROW_BYTES);
+    }
+}
+
+void glyph_free_grid(void) {
+    free_aligned(prevChars);
+    prevChars = NULL;
+    free(dirtySpans.row); free(dirtySpans.colBegin); free(dirtySpans.colEnd); free(dirtySpans.offset);
+    memset(&dirtySpans, 0, sizeof(dirtySpans));
+}
+
+int glyph_resize_grid(void) {
+    glyph_free_grid();
+    const int rows = height_chars;
+    prevChars = (unsigned char*)alloc_aligned((size_t)width_chars * rows);
+    dirtySpans.row = (int*)malloc(rows * sizeof(int));
+    dirtySpans.colBegin = (int*)malloc(rows * sizeof(int));
+    dirtySpans.colEnd = (int*)malloc(rows * sizeof(int));
+    dirtySpans.offset = (size_t*)malloc(rows * sizeof(size_t));
+    if (!prevChars || !dirtySpans.row || !dirtySpans.colBegin || !dirtySpans.colEnd || !dirtySpans.offset) return -1;
+    memset(prevChars, backgroundASCIICode, (size_t)width_chars * rows);
+    return 0;
+}
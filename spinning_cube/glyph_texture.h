@@ -0,0 +1,50 @@
+// glyph_texture.h
+// CPU glyph expansion for the ASCII grid (no GL dependency): the 8x8 font, RGBA tiles
+// per char code, the full texture build (on the raster pool), the dirty-span diff and
+// the glyph atlas the GPU path samples.
+#ifndef GLYPH_TEXTURE_H
+#define GLYPH_TEXTURE_H
+
+#include "ascii_raster.h"
+
+#include <stddef.h>
+
+// Font glyph size (pixels)
+#define GLYPH_W 8
+#define GLYPH_H 8
+#define GLYPH_ROW_BYTES (GLYPH_W * 4)
+// 16x16 glyphs, one byte per pixel
+#define ATLAS_W (16 * GLYPH_W)
+#define ATLAS_H (16 * GLYPH_H)
+
+// One span of changed cells per char row at most
+typedef struct {
+    int count;
+    int *row, *colBegin, *colEnd;    // height_chars entries each
+    size_t* offset;                  // byte offset of each span in the packed data
+    size_t bytes;                    // packed bytes in total = bytes uploaded
+    int cells;                       // changed cells
+} DirtySpans;
+
+extern unsigned char* texPixels;     // RGBA texture, width_chars * GLYPH_W x height_chars * GLYPH_H
+extern DirtySpans dirtySpans;
+extern unsigned char* prevChars;     // chars the texture currently shows
+
+void init_glyph_tiles(void);
+// Per-cell glyph search and per-bit writes of charBuffer into out (kept for the benches)
+void build_texture_reference(unsigned char* out);
+// charBuffer into out from the glyph tiles, bands of char rows on the raster pool
+void build_texture_into(unsigned char* out);
+void build_texture_from_charbuffer(void);
+void build_glyph_atlas(unsigned char* atlas);
+
+// Diffs chars against prev, records the spans and updates prev
+void diff_char_rows(unsigned char* prev, const unsigned char* chars, DirtySpans* d);
+// The tiles of the spans of d, packed span after span into dst
+void write_dirty_spans(unsigned char* dst, const unsigned char* chars, const DirtySpans* d);
+
+// prevChars / dirtySpans for the current grid size, prevChars set to the background
+int glyph_resize_grid(void);
+void glyph_free_grid(void);
+
+#endif
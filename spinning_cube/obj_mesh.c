@@ -0,0 +1,145 @@
+// obj_mesh.c
+// Wavefront OBJ loader, see obj_mesh.h.
+
+#include "obj_mesh.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    void* data;
+    int count, capacity;
+    size_t elem;
+} Growable;
+
+static int grow_push(Growable* g, const void* items, int n) {
+    if (g->count + n > g->capacity) {
+        int cap = g->capacity ? g->capacity : 1024;
+        while (cap < g->count + n) cap *= 2;
+        void* data = realloc(g->data, (size_t)cap * g->elem);
+        if (!data) return -1;
+        g->data = data;
+        g->capacity = cap;
+    }
+    memcpy((char*)g->data + (size_t)g->count * g->elem, items, (size_t)n * g->elem);
+    g->count += n;
+    return 0;
+}
+
+static const char* skip_blank(const char* p) {
+    while (*p == ' ' || *p == '\t') ++p;
+    return p;
+}
+
+// One face vertex "v", "v/vt", "v//vn" or "v/vt/vn" -> 0-based position index, or -1
+static int parse_face_index(const char** p, int vertexCount) {
+    char* end;
+    long v = strtol(*p, &end, 10);
+    if (end == *p) return -1;
+    while (*end && *end != ' ' && *end != '\t' && *end != '\r' && *end != '\n') ++end;
+    *p = end;
+    long idx = v > 0 ? v - 1 : vertexCount + v;
+    return (v != 0 && idx >= 0 && idx < vertexCount) ? (int)idx : -1;
+}
+
+int obj_mesh_load(ObjMesh* m, const char* path, char* err, size_t errSize) {
+    memset(m, 0, sizeof(*m));
+    if (errSize) err[0] = '\0';
+    FILE* f = fopen(path, "rb");
+    if (!f) { snprintf(err, errSize, "%s: cannot open", path); return -1; }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = (char*)malloc((size_t)(size > 0 ? size : 0) + 1);
+    if (!text) { fclose(f); snprintf(err, errSize, "%s: out of memory", path); return -1; }
+    size_t got = fread(text, 1, (size_t)(size > 0 ? size : 0), f);
+    fclose(f);
+    text[got] = '\0';
+
+    Growable pos = { NULL, 0, 0, sizeof(float) };
+    Growable tris = { NULL, 0, 0, sizeof(int) };
+    int rc = 0, line = 0;
+    for (char* p = text; *p && rc == 0; ) {
+        char* eol = strchr(p, '\n');
+        if (eol) *eol = '\0';
+        ++line;
+        const char* s = skip_blank(p);
+        if (s[0] == 'v' && (s[1] == ' ' || s[1] == '\t')) {
+            float xyz[3];
+            char* end;
+            const char* q = s + 1;
+            for (int k = 0; k < 3; ++k) {
+                xyz[k] = strtof(q, &end);
+                if (end == q) { snprintf(err, errSize, "%s:%d: bad vertex", path, line); rc = -1; break; }
+                q = end;
+            }
+            if (rc == 0 && grow_push(&pos, xyz, 3) != 0) rc = -1;
+        } else if (s[0] == 'f' && (s[1] == ' ' || s[1] == '\t')) {
+            const int vertexCount = pos.count / 3;
+            const char* q = skip_blank(s + 1);
+            int first = -1, prev = -1, n = 0;
+            while (*q && *q != '\r' && *q != '#') {
+                int idx = parse_face_index(&q, vertexCount);
+                if (idx < 0) { snprintf(err, errSize, "%s:%d: bad face index", path, line); rc = -1; break; }
+                if (n == 0) first = idx;
+                else if (n >= 2) {
+                    int tri[3] = { first, prev, idx };
+                    if (grow_push(&tris, tri, 3) != 0) { rc = -1; break; }
+                }
+                prev = idx;
+                ++n;
+                q = skip_blank(q);
+            }
+            if (rc == 0 && n < 3) { snprintf(err, errSize, "%s:%d: face with fewer than 3 vertices", path, line); rc = -1; }
+        }
+        p = eol ? eol + 1 : p + strlen(p);
+    }
+    free(text);
+    if (rc == 0 && tris.count == 0) { snprintf(err, errSize, "%s: no faces", path); rc = -1; }
+    if (rc != 0) {
+        if (!err[0]) snprintf(err, errSize, "%s: out of memory", path);
+        free(pos.data);
+        free(tris.data);
+        return -1;
+    }
+    m->positions = (float*)pos.data;
+    m->vertexCount = pos.count / 3;
+    m->indices = (int*)tris.data;
+    m->triangleCount = tris.count / 3;
+    return 0;
+}
+
+void obj_mesh_free(ObjMesh* m) {
+    free(m->positions);
+    free(m->indices);
+    memset(m, 0, sizeof(*m));
+}
+
+void obj_mesh_normalize(ObjMesh* m, float radius) {
+    if (m->vertexCount == 0) return;
+    float lo[3], hi[3];
+    for (int k = 0; k < 3; ++k) lo[k] = hi[k] = m->positions[k];
+    for (int i = 1; i < m->vertexCount; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            float v = m->positions[i * 3 + k];
+            if (v < lo[k]) lo[k] = v;
+            if (v > hi[k]) hi[k] = v;
+        }
+    }
+    float center[3], maxR2 = 0.0f;
+    for (int k = 0; k < 3; ++k) center[k] = 0.5f * (lo[k] + hi[k]);
+    for (int i = 0; i < m->vertexCount; ++i) {
+        float r2 = 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            float d = m->positions[i * 3 + k] - center[k];
+            r2 += d * d;
+        }
+        if (r2 > maxR2) maxR2 = r2;
+    }
+    float scale = maxR2 > 0.0f ? radius / sqrtf(maxR2) : 1.0f;
+    for (int i = 0; i < m->vertexCount; ++i)
+        for (int k = 0; k < 3; ++k)
+            m->positions[i * 3 + k] = (m->positions[i * 3 + k] - center[k]) * scale;
+}
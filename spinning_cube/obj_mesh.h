@@ -0,0 +1,24 @@
+// obj_mesh.h
+// Minimal Wavefront OBJ loader for the ASCII rasterizer: positions ("v") and faces
+// ("f", polygons fan-triangulated). Texture coordinates, normals, groups and
+// materials are ignored; face indices may be v, v/vt, v//vn or v/vt/vn, and
+// negative (relative) indices are accepted.
+#ifndef OBJ_MESH_H
+#define OBJ_MESH_H
+
+#include <stddef.h>
+
+typedef struct {
+    float* positions;      // xyz per vertex
+    int vertexCount;
+    int* indices;          // 3 per triangle
+    int triangleCount;
+} ObjMesh;
+
+// 0 on success; on failure err gets "path:line: message"
+int obj_mesh_load(ObjMesh* m, const char* path, char* err, size_t errSize);
+void obj_mesh_free(ObjMesh* m);
+// Centers the bounding box on the origin and scales the farthest vertex to radius
+void obj_mesh_normalize(ObjMesh* m, float radius);
+
+#endif
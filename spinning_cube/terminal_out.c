@@ -0,0 +1,151 @@
+// terminal_out.c
+// ANSI terminal output, see terminal_out.h.
+
+#include "terminal_out.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+// Gaps of unchanged cells up to this long are rewritten instead of repositioning
+// the cursor (a CUP sequence is 6-8 bytes)
+#define TERM_MAX_GAP 4
+
+static int term_reserve(TermOut* t, size_t extra) {
+    if (t->len + extra <= t->cap) return 0;
+    size_t cap = t->cap ? t->cap : 4096;
+    while (cap < t->len + extra) cap *= 2;
+    char* buf = (char*)realloc(t->buf, cap);
+    if (!buf) return -1;
+    t->buf = buf;
+    t->cap = cap;
+    return 0;
+}
+
+static void term_put(TermOut* t, const char* s, size_t n) {
+    if (term_reserve(t, n) != 0) return;
+    memcpy(t->buf + t->len, s, n);
+    t->len += n;
+}
+
+static void term_flush(TermOut* t) {
+    if (t->len) {
+        fwrite(t->buf, 1, t->len, stdout);   // one write of the whole frame
+        fflush(stdout);
+    }
+    t->len = 0;
+}
+
+int term_out_init(TermOut* t, int cols, int rows, int color) {
+    memset(t, 0, sizeof(*t));
+    t->cols = cols;
+    t->rows = rows;
+    t->color = color;
+    t->shownChars = (unsigned char*)calloc((size_t)cols * rows, 1);
+    t->shownColors = (uint32_t*)calloc((size_t)cols * rows, sizeof(uint32_t));
+    if (!t->shownChars || !t->shownColors) return -1;
+#ifdef _WIN32
+    HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(out, &mode)) SetConsoleMode(out, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+#endif
+    static const char start[] = "\x1b[?25l\x1b[0m\x1b[2J";
+    term_put(t, start, sizeof(start) - 1);
+    term_flush(t);
+    return 0;
+}
+
+void term_out_free(TermOut* t) {
+    char tail[48];
+    int n = snprintf(tail, sizeof(tail), "\x1b[0m\x1b[%d;1H\x1b[?25h", t->rows + 1);
+    term_put(t, tail, (size_t)n);
+    term_flush(t);
+    free(t->shownChars);
+    free(t->shownColors);
+    free(t->buf);
+    t->shownChars = NULL;
+    t->shownColors = NULL;
+    t->buf = NULL;
+}
+
+int term_out_resize(TermOut* t, int cols, int rows) {
+    unsigned char* shownChars = (unsigned char*)calloc((size_t)cols * rows, 1);
+    uint32_t* shownColors = (uint32_t*)calloc((size_t)cols * rows, sizeof(uint32_t));
+    if (!shownChars || !shownColors) { free(shownChars); free(shownColors); return -1; }
+    free(t->shownChars);
+    free(t->shownColors);
+    t->shownChars = shownChars;
+    t->shownColors = shownColors;
+    t->cols = cols;
+    t->rows = rows;
+    static const char clear[] = "\x1b[0m\x1b[2J";
+    term_put(t, clear, sizeof(clear) - 1);
+    return 0;
+}
+
+int term_out_query_size(int* cols, int* rows) {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return -1;
+    *cols = info.srWindow.Right - info.srWindow.Left + 1;
+    *rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+#else
+    struct winsize ws;
+    if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_col == 0) return -1;
+    *cols = ws.ws_col;
+    *rows = ws.ws_row;
+#endif
+    return 0;
+}
+
+size_t term_out_frame(TermOut* t, const unsigned char* chars, const uint32_t* colors) {
+    const int useColor = t->color && colors;
+    char seq[48];
+    uint32_t pen = 0xffffffffu;          // color set by the last SGR in this frame
+    for (int y = 0; y < t->rows; ++y) {
+        int cursor = -1;                 // column the cursor is at on this row, -1 = unknown
+        for (int x = 0; x < t->cols; ++x) {
+            int i = y * t->cols + x;
+            uint32_t c = useColor ? colors[i] : 0;
+            if (chars[i] == t->shownChars[i] && c == t->shownColors[i]) continue;
+            if (cursor < 0 || x < cursor || x - cursor > TERM_MAX_GAP) {
+                int n = snprintf(seq, sizeof(seq), "\x1b[%d;%dH", y + 1, x + 1);
+                term_put(t, seq, (size_t)n);
+            } else {
+                // rewrite the short gap of unchanged cells (with their own colors)
+                for (int g = cursor; g < x; ++g) {
+                    int gi = y * t->cols + g;
+                    if (useColor && t->shownColors[gi] != pen) {
+                        pen = t->shownColors[gi];
+                        int n = snprintf(seq, sizeof(seq), "\x1b[38;2;%u;%u;%um",
+                                         (pen >> 16) & 255u, (pen >> 8) & 255u, pen & 255u);
+                        term_put(t, seq, (size_t)n);
+                    }
+                    term_put(t, (const char*)&t->shownChars[gi], 1);
+                }
+            }
+            if (useColor && c != pen) {
+                pen = c;
+                int n = snprintf(seq, sizeof(seq), "\x1b[38;2;%u;%u;%um", (c >> 16) & 255u, (c >> 8) & 255u, c & 255u);
+                term_put(t, seq, (size_t)n);
+            }
+            term_put(t, (const char*)&chars[i], 1);
+            t->shownChars[i] = chars[i];
+            t->shownColors[i] = c;
+            cursor = x + 1;
+        }
+    }
+    size_t written = t->len;
+    term_flush(t);
+    if (t->frames == 0) t->firstFrameBytes = written;
+    t->frames++;
+    t->bytes += written;
+    return written;
+}
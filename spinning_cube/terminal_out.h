@@ -0,0 +1,35 @@
+// terminal_out.h
+// ANSI terminal output for a char grid (no GL / GLFW dependency).
+// Each frame is diffed against what the terminal already shows; only changed cells
+// are emitted, with cursor positioning between runs, and the whole frame goes out in
+// a single write. Optional 24-bit foreground color per cell.
+#ifndef TERMINAL_OUT_H
+#define TERMINAL_OUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    int cols, rows;
+    int color;                 // 1: emit 24-bit colors from the colors array
+    unsigned char* shownChars; // what the terminal shows (0 = unknown)
+    uint32_t* shownColors;     // 0xRRGGBB per cell
+    char* buf;                 // frame output
+    size_t len, cap;
+    unsigned long long frames, bytes;
+    size_t firstFrameBytes;    // full redraw
+} TermOut;
+
+// Hides the cursor and clears the screen; 0 on success
+int term_out_init(TermOut* t, int cols, int rows, int color);
+// Restores the cursor and colors below the grid
+void term_out_free(TermOut* t);
+// New grid size: clears the screen, the next frame is a full redraw; 0 on success
+int term_out_resize(TermOut* t, int cols, int rows);
+// Size of the terminal on stdout in cells; 0 on success, -1 if stdout is not a terminal
+int term_out_query_size(int* cols, int* rows);
+// Draws chars (cols x rows, row 0 at the top); colors may be NULL when color is off.
+// Returns the bytes written.
+size_t term_out_frame(TermOut* t, const unsigned char* chars, const uint32_t* colors);
+
+#endif
@@ -0,0 +1,170 @@
+// worker_pool.c
+// Persistent worker threads, see worker_pool.h.
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L   // sysconf under strict C11
+#endif
+
+#include "worker_pool.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef CRITICAL_SECTION pool_mutex;
+typedef CONDITION_VARIABLE pool_cond;
+#define pool_lock(m) EnterCriticalSection(m)
+#define pool_unlock(m) LeaveCriticalSection(m)
+#define pool_wait(c, m) SleepConditionVariableCS(c, m, INFINITE)
+#define pool_broadcast(c) WakeAllConditionVariable(c)
+#define pool_signal(c) WakeConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_mutex_t pool_mutex;
+typedef pthread_cond_t pool_cond;
+#define pool_lock(m) pthread_mutex_lock(m)
+#define pool_unlock(m) pthread_mutex_unlock(m)
+#define pool_wait(c, m) pthread_cond_wait(c, m)
+#define pool_broadcast(c) pthread_cond_broadcast(c)
+#define pool_signal(c) pthread_cond_signal(c)
+#endif
+
+typedef struct {
+    WorkerPool* pool;
+    int index;
+} WorkerArg;
+
+struct WorkerPool {
+    int size;                  // workers, the caller included
+    WorkerFn fn;
+    void* ctx;
+    unsigned generation;       // bumped by every run
+    int pending;               // helpers still busy with the current run
+    int quit;
+    pool_mutex lock;
+    pool_cond wake, done;
+    WorkerArg* args;
+#ifdef _WIN32
+    HANDLE* threads;
+#else
+    pthread_t* threads;
+#endif
+};
+
+int worker_pool_cpu_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwNumberOfProcessors > 0 ? (int)si.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+static void worker_loop(WorkerArg* arg) {
+    WorkerPool* pool = arg->pool;
+    unsigned seen = 0;
+    pool_lock(&pool->lock);
+    for (;;) {
+        while (!pool->quit && pool->generation == seen) pool_wait(&pool->wake, &pool->lock);
+        if (pool->quit) break;
+        seen = pool->generation;
+        WorkerFn fn = pool->fn;
+        void* ctx = pool->ctx;
+        pool_unlock(&pool->lock);
+        fn(ctx, arg->index, pool->size);
+        pool_lock(&pool->lock);
+        if (--pool->pending == 0) pool_signal(&pool->done);
+    }
+    pool_unlock(&pool->lock);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI worker_main(LPVOID p) { worker_loop((WorkerArg*)p); return 0; }
+#else
+static void* worker_main(void* p) { worker_loop((WorkerArg*)p); return NULL; }
+#endif
+
+WorkerPool* worker_pool_create(int workers) {
+    if (workers <= 0) workers = worker_pool_cpu_count();
+    WorkerPool* pool = (WorkerPool*)calloc(1, sizeof(WorkerPool));
+    if (!pool) return NULL;
+    pool->size = workers;
+    pool->args = (WorkerArg*)calloc(workers, sizeof(WorkerArg));
+    pool->threads = calloc(workers, sizeof(pool->threads[0]));
+    if (!pool->args || !pool->threads) {
+        free(pool->args); free(pool->threads); free(pool);
+        return NULL;
+    }
+#ifdef _WIN32
+    InitializeCriticalSection(&pool->lock);
+    InitializeConditionVariable(&pool->wake);
+    InitializeConditionVariable(&pool->done);
+#else
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+#endif
+    // worker 0 is the caller; a helper that fails to start shrinks the pool
+    int started = 1;
+    for (int i = 1; i < workers; ++i) {
+        pool->args[started].pool = pool;
+        pool->args[started].index = started;
+#ifdef _WIN32
+        pool->threads[started] = CreateThread(NULL, 0, worker_main, &pool->args[started], 0, NULL);
+        if (!pool->threads[started]) break;
+#else
+        if (pthread_create(&pool->threads[started], NULL, worker_main, &pool->args[started]) != 0) break;
+#endif
+        ++started;
+    }
+    pool->size = started;
+    return pool;
+}
+
+void worker_pool_destroy(WorkerPool* pool) {
+    if (!pool) return;
+    pool_lock(&pool->lock);
+    pool->quit = 1;
+    pool_broadcast(&pool->wake);
+    pool_unlock(&pool->lock);
+    for (int i = 1; i < pool->size; ++i) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->threads[i], INFINITE);
+        CloseHandle(pool->threads[i]);
+#else
+        pthread_join(pool->threads[i], NULL);
+#endif
+    }
+#ifdef _WIN32
+    DeleteCriticalSection(&pool->lock);
+#else
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+#endif
+    free(pool->args);
+    free(pool->threads);
+    free(pool);
+}
+
+int worker_pool_size(const WorkerPool* pool) {
+    return pool ? pool->size : 1;
+}
+
+void worker_pool_run(WorkerPool* pool, WorkerFn fn, void* ctx) {
+    if (!pool || pool->size <= 1) { fn(ctx, 0, 1); return; }
+    pool_lock(&pool->lock);
+    pool->fn = fn;
+    pool->ctx = ctx;
+    pool->pending = pool->size - 1;
+    pool->generation++;
+    pool_broadcast(&pool->wake);
+    pool_unlock(&pool->lock);
+    fn(ctx, 0, pool->size);
+    pool_lock(&pool->lock);
+    while (pool->pending > 0) pool_wait(&pool->done, &pool->lock);
+    pool_unlock(&pool->lock);
+}
@@ -0,0 +1,19 @@
+// worker_pool.h
+// Persistent worker threads for the cube rasterizer (pthreads, or Win32 threads).
+// worker_pool_run calls fn(ctx, worker, workers) once on every worker, the caller
+// being worker 0, and returns when all of them are done. Threads sleep between runs,
+// so a run per frame costs a wake-up, not a thread creation.
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+typedef void (*WorkerFn)(void* ctx, int worker, int workers);
+typedef struct WorkerPool WorkerPool;
+
+int worker_pool_cpu_count(void);
+// workers includes the calling thread; <= 0 means one per CPU. NULL on failure.
+WorkerPool* worker_pool_create(int workers);
+void worker_pool_destroy(WorkerPool* pool);
+int worker_pool_size(const WorkerPool* pool);
+void worker_pool_run(WorkerPool* pool, WorkerFn fn, void* ctx);
+
+#endif